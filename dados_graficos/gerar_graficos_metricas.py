@@ -34,7 +34,7 @@ ESTILOS = {'RR': '-', 'FCFS': '--', 'SJN': '-.', 'PRIORITY': ':'}
 
 def carregar_todos_csvs():
     """Carrega todos os CSVs de métricas e combina em um DataFrame único."""
-    configs_cores = [1, 2, 4, 6]
+    configs_cores = [1, 2, 4, 6, 16, 64, 256]
     dados = []
     
     for num_cores in configs_cores:
@@ -578,6 +578,122 @@ def grafico11_cache_analysis(df):
     print('✅ Gráfico 11 salvo: grafico11_cache_analysis.png/pdf')
     plt.close()
 
+    # Classificação 3C dos misses (CSVs antigos não têm as colunas)
+    colunas_3c = ['MissCompulsorio', 'MissCapacidade', 'MissConflito']
+    if not all(col in df.columns for col in colunas_3c):
+        return
+
+    fig, ax = plt.subplots(figsize=(14, 6))
+    cores_3c = {'MissCompulsorio': '#95a5a6', 'MissCapacidade': '#e67e22', 'MissConflito': '#c0392b'}
+    rotulos = [f'{politica}\n{c}c' for c in cores_list for politica in politicas]
+    base = np.zeros(len(rotulos))
+    for coluna in colunas_3c:
+        valores = []
+        for c in cores_list:
+            for politica in politicas:
+                linha = df[(df['Politica'] == politica) & (df['Cores'] == c)]
+                valores.append(linha[coluna].values[0] if len(linha) > 0 else 0)
+        valores = np.array(valores, dtype=float)
+        ax.bar(np.arange(len(valores)), valores, 0.7, bottom=base,
+               label=coluna.replace('Miss', ''), color=cores_3c[coluna], edgecolor='black', linewidth=0.6)
+        base += valores
+
+    ax.set_xticks(np.arange(len(rotulos)))
+    ax.set_xticklabels(rotulos, fontsize=8)
+    ax.set_ylabel('Misses da L1', fontweight='bold')
+    ax.set_title('Misses por Classe (Compulsório / Capacidade / Conflito)', fontweight='bold')
+    ax.legend(title='Classe', loc='best')
+    ax.grid(True, axis='y', linestyle='--', alpha=0.5)
+
+    plt.tight_layout()
+    plt.savefig('graficos/grafico11_cache_3c.png', dpi=150, bbox_inches='tight')
+    plt.savefig('graficos/grafico11_cache_3c.pdf', bbox_inches='tight')
+    print('✅ Gráfico 11 salvo: grafico11_cache_3c.png/pdf')
+    plt.close()
+
+
+def grafico12_heatmap_conjuntos():
+    """
+    GRÁFICO 12: Mapa de calor da L1
+    Taxa de miss de cada conjunto por núcleo, um gráfico por política
+    (maior configuração de cores com cache_conjuntos_{N}cores.csv).
+    """
+    arquivos = [f'dados_graficos/csv/cache_conjuntos_{n}cores.csv' for n in [6, 4, 2, 1]]
+    arquivo = next((a for a in arquivos if os.path.exists(a)), None)
+    if arquivo is None:
+        print('⚠️  Nenhum cache_conjuntos_*.csv encontrado; gráfico 12 ignorado')
+        return
+
+    df = pd.read_csv(arquivo)
+    politicas = [p for p in ['RR', 'FCFS', 'SJN', 'PRIORITY'] if p in df['Politica'].unique()]
+    if not politicas:
+        return
+
+    fig, axes = plt.subplots(len(politicas), 1, figsize=(14, 2.2 * len(politicas) + 1), squeeze=False)
+    for ax, politica in zip(axes[:, 0], politicas):
+        dados = df[df['Politica'] == politica]
+        acessos = dados.pivot(index='Core', columns='Conjunto', values='Acessos')
+        misses = dados.pivot(index='Core', columns='Conjunto', values='Misses')
+        taxa = (misses / acessos.replace(0, np.nan) * 100).fillna(0)
+
+        im = ax.imshow(taxa.values, cmap='Reds', aspect='auto', vmin=0, vmax=100)
+        ax.set_yticks(np.arange(len(taxa.index)))
+        ax.set_yticklabels([f'Core {c}' for c in taxa.index])
+        ax.set_title(politica, fontweight='bold')
+        fig.colorbar(im, ax=ax, label='Miss (%)')
+    axes[-1, 0].set_xlabel('Conjunto da L1', fontweight='bold')
+
+    plt.tight_layout()
+    plt.savefig('graficos/grafico12_heatmap_conjuntos.png', dpi=150, bbox_inches='tight')
+    plt.savefig('graficos/grafico12_heatmap_conjuntos.pdf', bbox_inches='tight')
+    print('✅ Gráfico 12 salvo: grafico12_heatmap_conjuntos.png/pdf')
+    plt.close()
+
+
+def grafico13_barramento(df):
+    """
+    GRÁFICO 13: Saturação do barramento
+    Ciclos de espera pelo árbitro e fração de memory_cycles gasta na fila, por cores.
+    """
+    colunas = ['BusWaitCycles', 'MemoryCycles']
+    if not all(col in df.columns for col in colunas):
+        print('⚠️  CSVs sem colunas do barramento; gráfico 13 ignorado')
+        return
+    if 'BusTransfers' in df.columns and df['BusTransfers'].sum() == 0:
+        print('⚠️  Métricas geradas sem barramento (TEST_BUS_WIDTH); gráfico 13 ignorado')
+        return
+
+    fig, (ax1, ax2) = plt.subplots(1, 2, figsize=(14, 6))
+    politicas = ['RR', 'FCFS', 'SJN', 'PRIORITY']
+    cores_list = sorted(df['Cores'].unique())
+
+    for politica in politicas:
+        dados_pol = df[df['Politica'] == politica].sort_values('Cores')
+        if dados_pol.empty:
+            continue
+        cor = CORES_POLITICAS.get(politica, '#95a5a6')
+        espera = dados_pol['BusWaitCycles'].values
+        fracao = dados_pol['BusWaitCycles'] / dados_pol['MemoryCycles'].replace(0, np.nan) * 100
+        ax1.plot(dados_pol['Cores'], espera, marker='o', label=politica, color=cor, linewidth=2)
+        ax2.plot(dados_pol['Cores'], fracao.fillna(0).values, marker='o', label=politica, color=cor, linewidth=2)
+
+    ax1.set_xlabel('Número de Cores', fontweight='bold')
+    ax1.set_ylabel('Ciclos de espera', fontweight='bold')
+    ax1.set_title('Espera pelo Árbitro do Barramento', fontweight='bold')
+    ax2.set_xlabel('Número de Cores', fontweight='bold')
+    ax2.set_ylabel('Espera / ciclos de memória (%)', fontweight='bold')
+    ax2.set_title('Fração da Latência de Memória na Fila', fontweight='bold')
+    for ax in (ax1, ax2):
+        ax.set_xticks(cores_list)
+        ax.legend(title='Política', loc='best')
+        ax.grid(True, linestyle='--', alpha=0.5)
+
+    plt.tight_layout()
+    plt.savefig('graficos/grafico13_barramento.png', dpi=150, bbox_inches='tight')
+    plt.savefig('graficos/grafico13_barramento.pdf', bbox_inches='tight')
+    print('✅ Gráfico 13 salvo: grafico13_barramento.png/pdf')
+    plt.close()
+
 
 def gerar_tabela_resumo(df):
     """Gera uma tabela resumo em texto."""
@@ -646,6 +762,8 @@ def main():
     grafico9_radar_4cores(df)
     grafico10_comparativo_geral(df)
     grafico11_cache_analysis(df)
+    grafico12_heatmap_conjuntos()
+    grafico13_barramento(df)
     
     # Gerar tabela resumo
     gerar_tabela_resumo(df)
@@ -667,6 +785,8 @@ def main():
     print('   • grafico9_radar_4cores.png/pdf - Radar chart (4 cores)')
     print('   • grafico10_comparativo_geral.png/pdf - Comparativo 6 métricas')
     print('   • grafico11_cache_analysis.png/pdf - Análise de cache')
+    print('   • grafico11_cache_3c.png/pdf - Misses por classe (3C)')
+    print('   • grafico12_heatmap_conjuntos.png/pdf - Mapa de calor dos conjuntos da L1')
     print()
 
 
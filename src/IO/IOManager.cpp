@@ -1,18 +1,14 @@
 #include "IOManager.hpp"
+#include <algorithm>
+#include <cctype>
 #include <iostream>
-#include <chrono>
 #include <fstream>
-#include <cstdlib>
-#include <ctime>
 
 // Construtor
-IOManager::IOManager() :
-    printer_requesting(false),
-    disk_requesting(false),
-    network_requesting(false),
-    shutdown_flag(false)
-{
-    srand(time(nullptr));
+IOManager::IOManager() : rng(IO_RANDOM_SEED) {
+    for (size_t i = 0; i < IO_DEVICE_COUNT; ++i) {
+        models[i] = defaultModel(static_cast<IODevice>(i));
+    }
 
     resultFile.open("result.dat", std::ios::app);
     outputFile.open("output.dat", std::ios::app);
@@ -21,112 +17,191 @@ IOManager::IOManager() :
         std::cerr << "Erro: não foi possível abrir arquivos de saída." << std::endl;
     }
 
-    managerThread = std::thread(&IOManager::managerLoop, this);
+    eventThread = std::thread(&IOManager::eventLoop, this);
 }
 
-// Destrutor
+// Destrutor: acorda a thread de eventos e espera ela terminar
 IOManager::~IOManager() {
-    shutdown_flag = true;
-    if (managerThread.joinable()) {
-        managerThread.join();
+    {
+        std::lock_guard<std::mutex> lock(queueLock);
+        shutdown_flag = true;
+    }
+    wakeup.notify_all();
+    drained.notify_all();
+    if (eventThread.joinable()) {
+        eventThread.join();
     }
     resultFile.close();
     outputFile.close();
 }
 
-// Adiciona um processo à lista de espera por I/O
-void IOManager::registerProcessWaitingForIO(PCB* process) {
-    std::lock_guard<std::mutex> lock(waiting_processes_lock);
-    waiting_processes.push_back(process);
+// Impressora lenta e regular, disco com busca/rotação variáveis, rede com latência base e cauda longa
+IODeviceModel IOManager::defaultModel(IODevice device) {
+    switch (device) {
+        case IODevice::Printer: return {2000, 1000, 0.0};
+        case IODevice::Disk:    return {500, 4000, 0.0};
+        default:                return {1000, 0, 2000.0};
+    }
 }
 
-// Adiciona uma requisição criada à fila de processamento
-void IOManager::addRequest(std::unique_ptr<IORequest> request) {
+void IOManager::setDeviceModel(IODevice device, const IODeviceModel& model) {
     std::lock_guard<std::mutex> lock(queueLock);
-    requests.push_back(std::move(request));
+    models[static_cast<size_t>(device)] = model;
 }
 
-void IOManager::managerLoop() {
-    while (!shutdown_flag) {
-        // ETAPA 1: Simula os dispositivos solicitando uma operação
-        {
-            std::lock_guard<std::mutex> lock(device_state_lock);
-            if (rand() % 100 == 0) {
-                if (!printer_requesting) {
-                    printer_requesting = true;
-                    // std::cout << "I/O Manager: [Impressora] está solicitando uma operação." << std::endl;
-                }
-            }
-            if (rand() % 50 == 0) {
-                if (!disk_requesting) {
-                    disk_requesting = true;
-                    // std::cout << "I/O Manager: [Disco] está solicitando uma operação." << std::endl;
-                }
-            }
-        }
+// Publica o pedido sem trava; a trava só é tomada para acordar a thread de eventos se ela dorme
+void IOManager::submit(std::unique_ptr<IORequest> request, uint64_t now) {
+    request->arrival = now;
+    outstanding.fetch_add(1);
+    incoming.push(std::move(request));
+    if (consumer_sleeping.load()) {
+        std::lock_guard<std::mutex> lock(queueLock);
+        wakeup.notify_one();
+    }
+}
 
-        // ETAPA 2: Verifica se há dispositivos solicitando E processos esperando
-        std::unique_ptr<IORequest> new_request = nullptr;
-        {
-            std::lock_guard<std::mutex> wplock(waiting_processes_lock);
-            if (!waiting_processes.empty()) {
-                std::lock_guard<std::mutex> dslock(device_state_lock);
-                PCB* process_to_service = waiting_processes.front();
-
-                if (printer_requesting) {
-                    new_request = std::make_unique<IORequest>();
-                    new_request->operation = "print_job";
-                    new_request->msg = "Imprimindo documento...";
-                    printer_requesting = false;
-                } else if (disk_requesting) {
-                    new_request = std::make_unique<IORequest>();
-                    new_request->operation = "read_from_disk";
-                    new_request->msg = "Lendo dados do disco...";
-                    disk_requesting = false;
-                }
-                
-                if (new_request) {
-                    new_request->process = process_to_service;
-                    waiting_processes.erase(waiting_processes.begin());
-                    new_request->cost_cycles = std::chrono::milliseconds((rand() % 3 + 1) * 100);
-                }
-            }
-        }
-        
-        if (new_request) {
-            addRequest(std::move(new_request));
-        }
+void IOManager::registerProcessWaitingForIO(PCB* process, uint64_t now) {
+    auto request = std::make_unique<IORequest>();
+    request->process = process;
+    request->pid = process->pid;
+    submit(std::move(request), now);
+}
 
-        // ETAPA 3: Processa a próxima requisição na fila
-        std::unique_ptr<IORequest> req_to_process = nullptr;
-        {
-            std::lock_guard<std::mutex> lock(queueLock);
-            if (!requests.empty()) {
-                req_to_process = std::move(requests.front());
-                requests.erase(requests.begin());
-            }
-        }
+void IOManager::waitForCompletions() {
+    std::unique_lock<std::mutex> lock(queueLock);
+    drained.wait(lock, [&] { return shutdown_flag || outstanding.load() == 0; });
+}
 
-        if (req_to_process) {
-            auto start = std::chrono::steady_clock::now();
-            std::this_thread::sleep_for(req_to_process->cost_cycles);
-            auto end = std::chrono::steady_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+// Agenda a operação no dispositivo (FIFO: começa quando a anterior termina). Chamar com queueLock
+void IOManager::schedule(std::unique_ptr<IORequest> request) {
+    if (request->device == IODevice::Any) request->device = chooseDevice();
+    const size_t index = static_cast<size_t>(request->device);
+    request->operation = operationName(request->device);
+    if (request->msg.empty()) request->msg = operationMessage(request->device);
+    request->cost_cycles = sampleLatency(request->device);
+    // Chega no relógio de quem pediu; a fila do dispositivo é que ordena no tempo
+    if (request->arrival == 0) request->arrival = clock;
+    request->completion = std::max(request->arrival, device_free_at[index]) + request->cost_cycles;
+    device_free_at[index] = request->completion;
+    events.push(std::move(request));
+}
 
-            // Incrementa ciclos de I/O no PCB
-            req_to_process->process->io_cycles.fetch_add(duration);
+size_t IOManager::getWaitingCount() const {
+    std::lock_guard<std::mutex> lock(queueLock);
+    size_t waiting = 0;
+    for (uint64_t free_at : device_free_at) {
+        if (free_at > clock) ++waiting;
+    }
+    // Processos com operação agendada além da que o dispositivo está executando
+    return events.size() > waiting ? events.size() - waiting : 0;
+}
 
-            std::cout << "I/O Manager: Processo " << req_to_process->process->pid 
-                    << " executou '" << req_to_process->operation << "'\n";
+// O disco é pedido duas vezes mais que a impressora e a rede (chamar com queueLock)
+IODevice IOManager::chooseDevice() {
+    static const std::array<IODevice, 4> weighted = {IODevice::Printer, IODevice::Disk, IODevice::Disk, IODevice::Network};
+    return weighted[rng() % weighted.size()];
+}
 
-            resultFile << "Processo " << req_to_process->process->pid << " -> " 
-                    << req_to_process->operation << " : " << req_to_process->msg << "\n";
-            outputFile << req_to_process->process->pid << "," 
-                    << req_to_process->operation << "," << duration << "ms\n";
+// Chamar com queueLock
+uint64_t IOManager::sampleLatency(IODevice device) {
+    const IODeviceModel& model = models[static_cast<size_t>(device)];
+    uint64_t latency = model.base;
+    if (model.jitter > 0) {
+        latency += std::uniform_int_distribution<uint64_t>(0, model.jitter)(rng);
+    }
+    if (model.tail_mean > 0.0) {
+        latency += static_cast<uint64_t>(std::exponential_distribution<double>(1.0 / model.tail_mean)(rng));
+    }
+    return std::max<uint64_t>(latency, 1);
+}
 
-            req_to_process->process->state = State::Ready;
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+bool IOManager::parseDevice(const std::string& name, IODevice& device) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    for (size_t i = 0; i < IO_DEVICE_COUNT; ++i) {
+        if (lower == deviceName(static_cast<IODevice>(i))) {
+            device = static_cast<IODevice>(i);
+            return true;
         }
     }
+    return false;
+}
+
+const char* IOManager::deviceName(IODevice device) {
+    switch (device) {
+        case IODevice::Printer: return "printer";
+        case IODevice::Disk:    return "disk";
+        case IODevice::Any:     return "any";
+        default:                return "network";
+    }
+}
+
+const char* IOManager::operationName(IODevice device) {
+    switch (device) {
+        case IODevice::Printer: return "print_job";
+        case IODevice::Disk:    return "read_from_disk";
+        default:                return "network_transfer";
+    }
+}
+
+const char* IOManager::operationMessage(IODevice device) {
+    switch (device) {
+        case IODevice::Printer: return "Imprimindo documento...";
+        case IODevice::Disk:    return "Lendo dados do disco...";
+        default:                return "Transferindo dados pela rede...";
+    }
+}
+
+// Entrega as conclusões em ordem de tempo simulado: o relógio de I/O salta direto
+// para o próximo evento, sem esperar tempo real. Pedidos novos são agendados antes
+// de cada entrega, para que uma conclusão mais cedo passe à frente.
+void IOManager::eventLoop() {
+    std::unique_lock<std::mutex> lock(queueLock);
+    std::unique_ptr<IORequest> request;
+    while (!shutdown_flag) {
+        while (incoming.pop(request)) schedule(std::move(request));
+
+        if (events.empty()) {
+            // seq_cst com o push: ou o produtor vê a flag e notifica, ou o predicado vê o pedido
+            consumer_sleeping.store(true);
+            wakeup.wait(lock, [&] { return shutdown_flag || !incoming.empty(); });
+            consumer_sleeping.store(false);
+            continue;
+        }
+
+        request = std::move(const_cast<std::unique_ptr<IORequest>&>(events.top()));
+        events.pop();
+        clock = std::max(clock, request->completion);
+        lock.unlock();
+        deliver(*request);
+        request.reset();
+        lock.lock();
+
+        if (outstanding.fetch_sub(1) == 1) drained.notify_all();
+    }
+}
+
+void IOManager::deliver(IORequest& request) {
+    if (request.process) {
+        // Ciclos de I/O do processo: fila do dispositivo + operação
+        request.process->io_cycles.fetch_add(request.completion - request.arrival);
+        request.process->io_ready_at.store(request.completion);
+    }
+    logCompletion(request);
+    if (request.on_complete) {
+        request.on_complete(request.process);
+    } else if (request.process) {
+        request.process->state = State::Ready;
+    }
+}
+
+void IOManager::logCompletion(const IORequest& request) {
+    std::cout << "I/O Manager: Processo " << request.pid
+              << " executou '" << request.operation << "'\n";
+
+    resultFile << "Processo " << request.pid << " -> "
+               << request.operation << " : " << request.msg << "\n";
+    outputFile << request.pid << ","
+               << request.operation << "," << request.completion - request.arrival << " ciclos\n";
 }
\ No newline at end of file
@@ -2,19 +2,50 @@
 #define IOMANAGER_HPP
 
 #include "../cpu/PCB.hpp"
-#include <vector>
+#include "MpscQueue.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <mutex>
+#include <queue>
+#include <random>
+#include <string>
 #include <thread>
 #include <memory>
 #include <fstream>
-#include <chrono>
+#include <vector>
+
+// Dispositivos atendidos pelo IOManager (Any = sorteado na chegada)
+enum class IODevice { Printer = 0, Disk = 1, Network = 2, Any = 3 };
+constexpr size_t IO_DEVICE_COUNT = 3;
+
+// Chamado na thread de eventos quando o I/O de um processo bloqueado termina
+using IOCompletion = std::function<void(PCB*)>;
 
 // Definição completa da estrutura IORequest
 struct IORequest {
     std::string operation;
     std::string msg;
-    PCB* process = nullptr; // Ponteiro para o PCB associado
-    std::chrono::milliseconds cost_cycles;
+    PCB* process = nullptr; // Processo bloqueado esperando a conclusão (nulo = sem retorno)
+    int pid = -1;                  // Para o log, mesmo sem processo associado
+    IODevice device = IODevice::Any;
+    IOCompletion on_complete;      // Vazio = o IOManager marca o processo como Ready
+    uint64_t cost_cycles = 0;      // Latência sorteada no modelo do dispositivo
+    uint64_t arrival = 0;          // Relógio de quem pediu (0 = relógio de I/O atual)
+    uint64_t completion = 0;       // Fim da operação (inclui a fila do dispositivo)
+};
+constexpr uint32_t IO_RANDOM_SEED = 42;   // Sorteios reproduzíveis entre execuções
+
+/**
+ * Distribuição de latência de um dispositivo, em ciclos simulados:
+ * base + uniforme[0, jitter] + exponencial com média `tail_mean` (cauda longa)
+ */
+struct IODeviceModel {
+    uint64_t base = 0;
+    uint64_t jitter = 0;
+    double tail_mean = 0.0;
 };
 
 class IOManager {
@@ -22,44 +53,75 @@ public:
     IOManager();
     ~IOManager();
 
-    // Método para um processo se registrar como "esperando por I/O"
-    void registerProcessWaitingForIO(PCB* process);
-    
-    // Retorna número de processos aguardando I/O
-    size_t getWaitingCount() const {
-        std::lock_guard<std::mutex> lock(waiting_processes_lock);
-        return waiting_processes.size();
-    }
+    // Entrega um pedido à thread de eventos por uma fila sem trava (seguro para
+    // vários núcleos ao mesmo tempo). `now` é o relógio simulado de quem pede.
+    void submit(std::unique_ptr<IORequest> request, uint64_t now);
+
+    // Método para um processo se registrar como "esperando por I/O" em um
+    // dispositivo sorteado; volta a Ready na conclusão
+    void registerProcessWaitingForIO(PCB* process, uint64_t now = 0);
+
+    // Espera todos os pedidos já enviados serem entregues (antes de destruir quem recebe os callbacks)
+    void waitForCompletions();
+
+    // Modelo de latência de um dispositivo (configurar antes de registrar processos)
+    void setDeviceModel(IODevice device, const IODeviceModel& model);
+    const IODeviceModel& getDeviceModel(IODevice device) const { return models[static_cast<size_t>(device)]; }
+    static IODeviceModel defaultModel(IODevice device);
+    static bool parseDevice(const std::string& name, IODevice& device);
+    static const char* deviceName(IODevice device);
+
+    // Retorna número de processos aguardando I/O (atrás de outra operação no dispositivo)
+    size_t getWaitingCount() const;
     
-    // Retorna número de requisições pendentes
-    size_t getRequestCount() const {
+    // Retorna número de requisições ainda não concluídas
+    size_t getRequestCount() const { return outstanding.load(); }
+
+    // Relógio de I/O: instante simulado do último evento entregue
+    uint64_t getClock() const {
         std::lock_guard<std::mutex> lock(queueLock);
-        return requests.size();
+        return clock;
     }
 
 private:
-    void managerLoop();
-    void addRequest(std::unique_ptr<IORequest> request);
+    struct LaterCompletion {
+        bool operator()(const std::unique_ptr<IORequest>& a, const std::unique_ptr<IORequest>& b) const {
+            return a->completion > b->completion;
+        }
+    };
 
-    // Fila de requisições prontas para serem executadas
-    std::vector<std::unique_ptr<IORequest>> requests;
-    mutable std::mutex queueLock;
+    void eventLoop();
+    void schedule(std::unique_ptr<IORequest> request);
+    void deliver(IORequest& request);
+    uint64_t sampleLatency(IODevice device);
+    IODevice chooseDevice();
+    void logCompletion(const IORequest& request);
+    static const char* operationName(IODevice device);
+    static const char* operationMessage(IODevice device);
+
+    std::array<IODeviceModel, IO_DEVICE_COUNT> models;
+    std::array<uint64_t, IO_DEVICE_COUNT> device_free_at{};   // Fim da última operação agendada
 
-    // Fila de processos que estão no estado BLOCKED esperando por um dispositivo
-    std::vector<PCB*> waiting_processes;
-    mutable std::mutex waiting_processes_lock;
+    // Pedidos recém-enviados: vários produtores (núcleos), a thread de eventos consome
+    MpscQueue<std::unique_ptr<IORequest>> incoming;
+    std::atomic<bool> consumer_sleeping{false};
+    std::atomic<size_t> outstanding{0};   // Enviados e ainda não entregues
+
+    // Conclusões pendentes, da mais próxima para a mais distante no relógio de I/O
+    std::priority_queue<std::unique_ptr<IORequest>, std::vector<std::unique_ptr<IORequest>>, LaterCompletion> events;
+    uint64_t clock = 0;
+    mutable std::mutex queueLock;
+    std::condition_variable wakeup;
+    std::condition_variable drained;
 
-    // Variáveis booleanas representando o estado de cada dispositivo (0/1)
-    bool printer_requesting;
-    bool disk_requesting;
-    bool network_requesting;
-    std::mutex device_state_lock;
+    // Sorteio do dispositivo e das latências (protegido por queueLock)
+    std::mt19937 rng;
 
-    bool shutdown_flag;
-    std::thread managerThread;
+    bool shutdown_flag = false;
+    std::thread eventThread;
 
     std::ofstream resultFile;
     std::ofstream outputFile;
 };
 
-#endif // IOMANAGER_HPP 
\ No newline at end of file
+#endif // IOMANAGER_HPP
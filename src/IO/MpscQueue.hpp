@@ -0,0 +1,62 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+/**
+ * MpscQueue - Fila sem trava com vários produtores e um único consumidor
+ *
+ * Lista encadeada com nó sentinela (algoritmo de Vyukov): o produtor troca a cabeça
+ * com um exchange e depois liga o nó anterior ao novo, então push nunca espera por
+ * outra thread. Só o consumidor anda pela cauda. Entre o exchange e a ligação o
+ * item ainda não aparece para o consumidor, que o verá no próximo pop.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head(new Node()), tail(head.load(std::memory_order_relaxed)) {}
+
+    ~MpscQueue() {
+        T discarded;
+        while (pop(discarded)) {}
+        delete tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Qualquer thread
+    void push(T value) {
+        Node* node = new Node(std::move(value));
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        // seq_cst: quem publica e depois olha se o consumidor dorme não perde o despertar
+        previous->next.store(node, std::memory_order_seq_cst);
+    }
+
+    // Só o consumidor
+    bool pop(T& value) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) return false;
+        value = std::move(next->value);
+        delete tail;
+        tail = next;   // O nó consumido vira a nova sentinela
+        return true;
+    }
+
+    // Só o consumidor
+    bool empty() const { return tail->next.load(std::memory_order_seq_cst) == nullptr; }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+        T value{};
+        std::atomic<Node*> next{nullptr};
+    };
+
+    std::atomic<Node*> head;   // Último nó publicado (produtores)
+    Node* tail;                // Sentinela (consumidor)
+};
+
+#endif // MPSC_QUEUE_HPP
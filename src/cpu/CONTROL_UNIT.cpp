@@ -113,7 +113,7 @@ void Control_Unit::Fetch(ControlContext &context) {
     // MAR <- PC
     context.registers.mar.write(context.registers.pc.value);
     // Read memory at MAR (endereçamento em bytes presunção: PC em bytes)
-    uint32_t instr = context.memManager.read(context.registers.mar.read(), context.process);
+    uint32_t instr = context.memManager.fetch(context.registers.mar.read(), context.process);
     context.registers.ir.write(instr);
 
     // === TRACE FETCH === (DESABILITADO PARA REDUZIR POLUIÇÃO)
@@ -206,6 +206,26 @@ void Control_Unit::Decode(hw::REGISTER_BANK &registers, Instruction_Data &data)
     // }
 }
 
+size_t Control_Unit::Operand_Registers(const Instruction_Data &data, uint32_t out[2]) {
+    size_t count = 0;
+    if (!data.source_register.empty()) out[count++] = binaryStringToUint(data.source_register);
+    // Nestas rt é só destino; nas demais (tipo R, SW, desvios, PRINT) também é lido
+    const bool rt_is_destination = data.op == "LW" || data.op == "LI" || data.op == "LA" ||
+                                   data.op == "ADDI" || data.op == "ADDIU" || data.op == "SLTI" ||
+                                   data.op == "LUI";
+    if (!data.target_register.empty() && !rt_is_destination) out[count++] = binaryStringToUint(data.target_register);
+    return count;
+}
+
+int Control_Unit::Destination_Register(const Instruction_Data &data) {
+    if (data.op == "ADD" || data.op == "SUB" || data.op == "MULT" || data.op == "DIV") {
+        return data.destination_register.empty() ? -1 : static_cast<int>(binaryStringToUint(data.destination_register));
+    }
+    const bool writes_rt = data.op == "LW" || data.op == "LI" || data.op == "LA" ||
+                           data.op == "ADDI" || data.op == "ADDIU" || data.op == "SLTI" ||
+                           data.op == "LUI";
+    return writes_rt && !data.target_register.empty() ? static_cast<int>(binaryStringToUint(data.target_register)) : -1;
+}
 
 void Control_Unit::Execute_Immediate_Operation(hw::REGISTER_BANK &registers, Instruction_Data &data) {
     std::string name_rs = this->map.getRegisterName(binaryStringToUint(data.source_register));
@@ -373,7 +393,8 @@ void Control_Unit::Memory_Acess(Instruction_Data &data, ControlContext &context)
     string name_rt = this->map.getRegisterName(binaryStringToUint(data.target_register));
     if (data.op == "LW") {
         uint32_t addr = binaryStringToUint(data.addressRAMResult);
-        int value = context.memManager.read(addr, context.process);
+        const int rt = static_cast<int>(binaryStringToUint(data.target_register));
+        int value = context.memManager.load(addr, context.process, rt);
         context.registers.writeRegister(name_rt, value);
 
         // std::cout << "[MEMORY] LW addr=" << addr << " value=" << value;
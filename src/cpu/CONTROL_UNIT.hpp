@@ -61,6 +61,10 @@ struct Control_Unit {
 
     void Fetch(ControlContext &context);
     void Decode(hw::REGISTER_BANK &registers, Instruction_Data &data);
+    // Registradores lidos pela instrução decodificada (scoreboard dos LW pendentes)
+    static size_t Operand_Registers(const Instruction_Data &data, uint32_t out[2]);
+    // Registrador escrito pela instrução (-1 se nenhum)
+    static int Destination_Register(const Instruction_Data &data);
     void Execute_Aritmetic_Operation(hw::REGISTER_BANK &registers, Instruction_Data &d);
     void Execute_Operation(Instruction_Data &data, ControlContext &context);
     void Execute_Loop_Operation(hw::REGISTER_BANK &registers, Instruction_Data &d,
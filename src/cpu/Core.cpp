@@ -6,13 +6,31 @@
 #include "TimeUtils.hpp"
 #include <iostream>
 #include <chrono>
+#include <algorithm>
 
-Core::Core(int id, MemoryManager* mem_manager) 
-    : core_id(id), memory_manager(mem_manager) 
+Core::Core(int id, MemoryManager* mem_manager, IOManager* io_manager, IOCompletion on_io_complete)
+    : core_id(id), memory_manager(mem_manager), io_manager(io_manager),
+      on_io_complete(std::move(on_io_complete))
 {
-    // Criar cache L1 privada (usa construtor padrão)
+    // Criar cache L1 privada (configuração vem do MemoryManager)
     // Cada núcleo tem sua própria cache para evitar contenção
-    L1_cache = std::make_unique<Cache>();
+    L1_cache = mem_manager ? std::make_unique<Cache>(mem_manager->getL1Config())
+                           : std::make_unique<Cache>();
+    if (mem_manager && mem_manager->hasSplitL1()) {
+        L1I_cache = std::make_unique<Cache>(mem_manager->getL1IConfig());
+        if (mem_manager->getFetchBufferLines() > 0) {
+            fetch_buffer = std::make_unique<FetchBuffer>(mem_manager->getFetchBufferLines(),
+                                                         L1I_cache->lineSize());
+        }
+    }
+    tlb = mem_manager ? std::make_unique<TLB>(mem_manager->getTLBConfig())
+                      : std::make_unique<TLB>();
+    if (mem_manager && mem_manager->getLsuConfig().enabled()) {
+        lsu = std::make_unique<LoadStoreUnit>(mem_manager->getLsuConfig(), mem_manager->getL1Config().line_size);
+    }
+    if (mem_manager && mem_manager->getTrace()) {
+        trace_buffer = std::make_unique<TraceBuffer>(*mem_manager->getTrace(), id);
+    }
     
     // std::cout << "[Core " << core_id << "] Inicializado com cache L1 privada\n";
 }
@@ -73,6 +91,42 @@ void Core::wait_completion() {
 void Core::run_process(PCB* process) {
     // 🔥 CRÍTICO: Registrar cache L1 privada desta thread
     MemoryManager::setThreadCache(L1_cache.get());
+    MemoryManager::setThreadICache(L1I_cache.get(), fetch_buffer.get());
+    MemoryManager::setThreadTLB(tlb.get());
+    MemoryManager::setThreadClock(&sim_clock);
+    MemoryManager::setThreadTrace(trace_buffer.get());
+    MemoryManager::setThreadLsu(lsu.get());
+    MemoryManager::setThreadNode(memory_manager->nodeOfCore(core_id));
+    MemoryManager::setThreadCore(core_id);
+    memory_manager->beginQuantum(*process, L1_cache.get(), eviction_cursor, L1I_cache.get());
+    if (fetch_buffer) fetch_buffer->clear();
+
+    // Linhas marcadas com o processo continuam válidas se ele não rodou em outro núcleo
+    // desde o último quantum aqui; senão podem estar velhas e são descartadas
+    const uint32_t cache_owner = process->asid != 0 ? process->asid : static_cast<uint32_t>(process->pid);
+    L1_cache->setOwner(cache_owner);
+    if (L1I_cache) L1I_cache->setOwner(cache_owner);
+    if (process->l1_core == core_id) {
+        process->l1_warm_lines += L1_cache->occupancy(cache_owner);
+    } else {
+        L1_cache->invalidateOwner(cache_owner, memory_manager);
+        if (L1I_cache) L1I_cache->invalidateOwner(cache_owner, nullptr);
+    }
+
+    // Núcleo que ficou ocioso alcança o tempo já visto pela DRAM, barramento e NoC
+    sim_clock = std::max(sim_clock, memory_manager->memoryClock());
+
+    // Volta de I/O: o processo só executa depois da conclusão. A parte da latência
+    // que este núcleo ainda não cobriu com outros processos vira espera
+    const uint64_t io_ready = process->io_ready_at.exchange(0);
+    if (io_ready > 0) {
+        const uint64_t issued = process->io_issued_at.load();
+        const uint64_t resume = std::max(sim_clock, issued);
+        const uint64_t stall = io_ready > resume ? io_ready - resume : 0;
+        process->io_stall_cycles += stall;
+        process->io_overlap_cycles += (io_ready > issued ? io_ready - issued : 0) - stall;
+        sim_clock = std::max(sim_clock, io_ready);
+    }
     
     // Estruturas de controle
     Control_Unit control_unit;
@@ -108,6 +162,7 @@ void Core::run_process(PCB* process) {
            cycles_in_quantum < process->quantum) {
         
         Instruction_Data data;
+        const uint64_t memory_cycles_before = process->memory_cycles.load();
         
         try {
             // Pipeline MIPS de 5 estágios
@@ -115,9 +170,20 @@ void Core::run_process(PCB* process) {
             if (context.endProgram) break;
             
             control_unit.Decode(context.registers, data);
+            if (lsu) {
+                // Operando ainda vindo de um LW: o pipeline espera aqui, não no LW
+                uint32_t operands[2];
+                const size_t count = Control_Unit::Operand_Registers(data, operands);
+                process->memory_cycles += lsu->waitOperands(operands, count, sim_clock);
+            }
             control_unit.Execute(data, context);
             control_unit.Memory_Acess(data, context);
             control_unit.Write_Back(data, context);
+            if (lsu && data.op != "LW") {
+                // Valor novo no registrador: leitores seguintes não esperam o LW antigo
+                const int dest = Control_Unit::Destination_Register(data);
+                if (dest >= 0) lsu->clearRegister(static_cast<uint32_t>(dest));
+            }
             
             // Contabiliza ciclo
             cycles_in_quantum++;
@@ -125,6 +191,7 @@ void Core::run_process(PCB* process) {
             
             // 🆕 RASTREAR CICLO BUSY
             busy_cycles++;
+            sim_clock += 1 + (process->memory_cycles.load() - memory_cycles_before);
             
         } catch (const std::exception& e) {
             std::cerr << "[Core " << core_id << "] Erro na execução de P" 
@@ -134,16 +201,38 @@ void Core::run_process(PCB* process) {
         }
     }
     
+    if (lsu) {
+        // Nada fica em andamento na troca de contexto: espera o store buffer e os MSHRs
+        const uint64_t drain = lsu->drain(sim_clock);
+        process->memory_cycles += drain;
+        sim_clock += drain;
+        const LsuStats lsu_stats = lsu->takeStats();
+        if (lsu_stats.latency > lsu_stats.stalls) process->mlp_overlap_cycles += lsu_stats.latency - lsu_stats.stalls;
+        process->store_forwards += lsu_stats.forwards;
+        process->mshr_merges += lsu_stats.merges;
+    }
+
+    // Troca de contexto: linhas sujas voltam para a memória compartilhada,
+    // pois o processo pode ser retomado em outro núcleo
+    L1_cache->writeBackDirty(memory_manager);
+    memory_manager->endQuantum(*process);
+    if (trace_buffer) trace_buffer->flush();
+    process->l1_core = core_id;
+    const uint64_t resident_lines = L1_cache->occupancy(cache_owner);
+    if (resident_lines > process->l1_lines_peak) process->l1_lines_peak = resident_lines;
+    
     // Determina o estado final do processo
     if (context.endProgram) {
         process->state = State::Finished;
         process->finish_time = cpu_time::now_ns();
+        // Segmento da imagem volta para o alocador (pode receber outro processo)
+        memory_manager->releaseProcessMemory(*process);
         
         // std::cout << "[Core " << core_id << "] P" << process->pid 
         //           << " FINALIZADO (total: " << process->pipeline_cycles.load() 
         //           << " ciclos)\n";
         
-    } else if (!ioRequests.empty()) {
+    } else if (!ioRequests.empty() && io_manager) {
         process->state = State::Blocked;
         
         // std::cout << "[Core " << core_id << "] P" << process->pid 
@@ -160,6 +249,22 @@ void Core::run_process(PCB* process) {
         //           << cycles_in_quantum << " ciclos)\n";
     }
     
+    // PRINTs vão para o IOManager; o processo bloqueado só volta a Ready pelo
+    // callback do escalonador na conclusão (pode chegar antes da coleta deste núcleo)
+    for (auto& request : ioRequests) {
+        if (!io_manager) break;
+        request->device = IODevice::Printer;
+        request->pid = process->pid;
+        process->io_requests++;
+        if (process->state == State::Blocked && &request == &ioRequests.back()) {
+            request->on_complete = on_io_complete;
+            process->io_issued_at = sim_clock;
+        } else {
+            request->process = nullptr;   // Sem retorno: o processo terminou ou não espera este
+        }
+        io_manager->submit(std::move(request), sim_clock);
+    }
+
     // NÃO liberar núcleo aqui - isso será feito após o collect no scheduler!
     // Apenas marcar como idle para que scheduler saiba que terminou
     state.store(CoreState::IDLE);
@@ -8,6 +8,9 @@
 #include "CONTROL_UNIT.hpp"
 #include "REGISTER_BANK.hpp"
 #include "../memory/cache.hpp"
+#include "../memory/TLB.hpp"
+#include "../memory/MemoryManager.hpp"
+#include "../IO/IOManager.hpp"
 // Logging API used by tests
 #include "../log/Log.hpp"
 
@@ -22,8 +25,11 @@ public:
      * Construtor do núcleo
      * @param id Identificador único do núcleo
      * @param mem_manager Ponteiro para o gerenciador de memória compartilhada
+     * @param io_manager Recebe os PRINTs do pipeline (nulo = PRINTs descartados, sem bloqueio)
+     * @param on_io_complete Chamado pelo IOManager quando o processo bloqueado pode voltar
      */
-    Core(int id, MemoryManager* mem_manager);
+    Core(int id, MemoryManager* mem_manager, IOManager* io_manager = nullptr,
+         IOCompletion on_io_complete = nullptr);
     
     /**
      * Destrutor - aguarda término de threads
@@ -90,6 +96,11 @@ public:
     int get_id() const { 
         return core_id; 
     }
+
+    // Cache L1 do núcleo (contadores 3C e por conjunto)
+    const Cache& get_l1_cache() const { return *L1_cache; }
+    // L1I do núcleo (nula com a L1 unificada)
+    const Cache* get_l1i_cache() const { return L1I_cache.get(); }
     
     // 🆕 NOVOS MÉTODOS PARA RASTREAMENTO DE CICLOS
     uint64_t get_busy_cycles() const { return busy_cycles.load(); }
@@ -121,9 +132,27 @@ private:
     
     // Memória compartilhada (gerenciada externamente)
     MemoryManager* memory_manager;
+
+    // I/O (gerenciado externamente) e callback do escalonador dono deste núcleo
+    IOManager* io_manager;
+    IOCompletion on_io_complete;
     
     // Cache L1 privada (cada núcleo tem a sua)
     std::unique_ptr<Cache> L1_cache;
+    // L1I e buffer de busca (nulos com a L1 unificada: a busca usa a L1 de dados)
+    std::unique_ptr<Cache> L1I_cache;
+    std::unique_ptr<FetchBuffer> fetch_buffer;
+
+    // TLB privada (entradas marcadas por ASID, sobrevive às trocas de contexto)
+    std::unique_ptr<TLB> tlb;
+    EvictionCursor eviction_cursor;  // Quadros despejados já descartados desta L1
+    uint64_t sim_clock = 0;          // Relógio simulado: ciclos de pipeline + memória executados aqui
+
+    // Store buffer + MSHRs (nulo se desligados: acessos bloqueantes)
+    std::unique_ptr<LoadStoreUnit> lsu;
+
+    // Acessos deste núcleo para o trace (nulo se --trace não foi pedido)
+    std::unique_ptr<TraceBuffer> trace_buffer;
     
     // Thread de execução
     std::thread execution_thread;
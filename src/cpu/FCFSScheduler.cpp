@@ -9,7 +9,8 @@ FCFSScheduler::FCFSScheduler(int num_cores, MemoryManager* memManager, IOManager
     
     
     for (int i = 0; i < num_cores; i++) {
-        cores.push_back(std::make_unique<Core>(i, memManager));
+        cores.push_back(std::make_unique<Core>(i, memManager, ioManager,
+            [this](PCB* process) { io_completions.push(process); }));
         cores[i]->reset_metrics();
     }
     
@@ -33,6 +34,8 @@ FCFSScheduler::~FCFSScheduler() {
             core->wait_completion();
         }
     }
+    // Callbacks de I/O ainda a caminho apontam para este escalonador
+    if (ioManager) ioManager->waitForCompletions();
     
     // Limpar filas
     std::lock_guard<std::mutex> lock(scheduler_mutex);
@@ -89,7 +92,6 @@ void FCFSScheduler::collect_finished_processes() {
                 }
                 break;
             case State::Blocked:
-                ioManager->registerProcessWaitingForIO(process);
                 blocked_list.push_back(process);
                 break;
             default:
@@ -130,37 +132,11 @@ void FCFSScheduler::schedule_cycle() {
     if (current_time % batch_size == 0 || should_schedule) {
         std::lock_guard<std::mutex> lock(scheduler_mutex);
         
-        // Desbloqueia processos do IO
-        // Como o IOManager é probabilístico, forçamos o desbloqueio para evitar starvation
-        for (auto it = blocked_list.begin(); it != blocked_list.end(); ) {
-            PCB* p = *it;
-            
-            // Verificar se o processo já está sendo executado em algum core
-            bool already_running = false;
-            for (const auto& c : cores) {
-                if (c->get_current_process() == p) {
-                    already_running = true;
-                    break;
-                }
-            }
-            
-            if (already_running) {
-                // Processo já está rodando, remover da blocked_list mas não adicionar à ready_queue
-                it = blocked_list.erase(it);
-                continue;
-            }
-            
-            // Forçar desbloqueio: simula conclusão instantânea do I/O
-            if (p->state == State::Blocked) {
-                p->state = State::Ready;
-            }
-            if (p->state == State::Ready) {
-                enqueue_ready_process(p);
-                it = blocked_list.erase(it);
-            } else {
-                ++it;
-            }
-        }
+        // Processos cujo I/O terminou voltam para a fila de prontos
+        io_completions.release(blocked_list, [this](PCB* process) {
+            process->state = State::Ready;
+            enqueue_ready_process(process);
+        });
         
         // Atribui processos aos núcleos livres (FIFO)
         size_t max_attempts = ready_queue.size() * 2;
@@ -185,7 +161,6 @@ void FCFSScheduler::schedule_cycle() {
                             finished_count.fetch_add(1);
                         } else if (old_process->state == State::Blocked) {
                             // Processo bloqueado: adicionar à blocked_list
-                            ioManager->registerProcessWaitingForIO(old_process);
                             blocked_list.push_back(old_process);
                         } else if (old_process->state == State::Ready) {
                             enqueue_ready_process(old_process);
@@ -0,0 +1,49 @@
+#ifndef IO_COMPLETION_QUEUE_HPP
+#define IO_COMPLETION_QUEUE_HPP
+
+#include <unordered_set>
+#include <vector>
+#include "PCB.hpp"
+#include "../IO/MpscQueue.hpp"
+
+/**
+ * IOCompletionQueue - Conclusões de I/O entregues a um escalonador
+ *
+ * O IOManager empilha o PCB sem trava (push, na thread de eventos); o escalonador
+ * chama release() sob a sua trava. Um I/O curto pode terminar antes de o processo
+ * ser coletado do núcleo: a conclusão fica guardada até ele aparecer na lista de
+ * bloqueados.
+ */
+class IOCompletionQueue {
+public:
+    // Qualquer thread
+    void push(PCB* process) { incoming.push(process); }
+
+    // Só o escalonador: tira de `blocked` os processos concluídos (mantendo a ordem
+    // dos demais) e entrega cada um a `ready`. Uma passada por `blocked`.
+    template <typename Blocked, typename Ready>
+    void release(Blocked& blocked, Ready&& ready) {
+        PCB* process = nullptr;
+        while (incoming.pop(process)) pending.insert(process);
+        if (pending.empty()) return;
+
+        auto kept = blocked.begin();
+        for (auto it = blocked.begin(); it != blocked.end(); ++it) {
+            if (pending.erase(*it) > 0) {
+                ready(*it);
+            } else {
+                *kept++ = *it;
+            }
+        }
+        blocked.erase(kept, blocked.end());
+    }
+
+    // Concluídos esperando a coleta do núcleo
+    size_t waiting() const { return pending.size(); }
+
+private:
+    MpscQueue<PCB*> incoming;
+    std::unordered_set<PCB*> pending;
+};
+
+#endif // IO_COMPLETION_QUEUE_HPP
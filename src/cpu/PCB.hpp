@@ -9,7 +9,10 @@
 #include <string>
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include "memory/cache.hpp"
+#include "memory/AddressSpace.hpp"
+#include "memory/ReuseProfiler.hpp"
 #include "REGISTER_BANK.hpp" // necessidade de objeto completo dentro do PCB
 #include "TimeUtils.hpp"
 
@@ -54,7 +57,42 @@ struct PCB {
     // Novos contadores
     std::atomic<uint64_t> cache_hits{0};
     std::atomic<uint64_t> cache_misses{0};
+    std::atomic<uint64_t> miss_compulsory{0};   // 3C dos misses da L1
+    std::atomic<uint64_t> miss_capacity{0};
+    std::atomic<uint64_t> miss_conflict{0};
+    std::atomic<uint64_t> prefetch_issued{0};   // Linhas trazidas por prefetch
+    std::atomic<uint64_t> prefetch_hits{0};     // Prefetches que chegaram a ser usados
+    std::atomic<uint64_t> tlb_hits{0};
+    std::atomic<uint64_t> tlb_misses{0};
+    std::atomic<uint64_t> page_walk_cycles{0};  // Ciclos gastos percorrendo a tabela de páginas
+    std::atomic<uint64_t> page_faults{0};
+    std::atomic<uint64_t> cow_copies{0};        // Páginas compartilhadas copiadas na primeira escrita
+    std::atomic<uint64_t> fault_service_cycles{0}; // Ciclos de swap-in/swap-out das faltas
+    std::atomic<uint64_t> dram_row_hits{0};
+    std::atomic<uint64_t> dram_row_misses{0};
+    std::atomic<uint64_t> dram_row_conflicts{0};
+    std::atomic<uint64_t> dram_queue_cycles{0}; // Espera atrás de pedidos de outros núcleos
+    std::atomic<uint64_t> remote_mem_accesses{0}; // Acessos à RAM de outro nó NUMA
+    std::atomic<uint64_t> mlp_overlap_cycles{0};  // Latência escondida pelo store buffer/MSHRs
+    std::atomic<uint64_t> store_forwards{0};      // LW servidos pelo store buffer
+    std::atomic<uint64_t> mshr_merges{0};         // Acessos a uma linha que já estava a caminho
+    std::atomic<uint64_t> ifetch_accesses{0};     // Buscas de instrução (L1I separada)
+    std::atomic<uint64_t> ifetch_hits{0};
+    std::atomic<uint64_t> ifetch_misses{0};
+    std::atomic<uint64_t> fetch_buffer_hits{0};   // Buscas servidas pelo buffer de busca
+    std::atomic<uint64_t> fetch_cycles{0};        // Parte de memory_cycles gasta em buscas
+    std::atomic<uint64_t> l2_hits{0};             // Misses da L1 resolvidos na L2 compartilhada
+    std::atomic<uint64_t> l2_misses{0};
+    std::atomic<uint64_t> bus_transfers{0};       // Transferências com a RAM pelo barramento
+    std::atomic<uint64_t> bus_queue_cycles{0};    // Espera pelo árbitro do barramento
+    std::atomic<uint64_t> noc_cycles{0};          // Latência das mensagens na rede-em-chip
+    std::atomic<uint64_t> noc_wait_cycles{0};     // Parte de noc_cycles esperando enlaces
     std::atomic<uint64_t> io_cycles{1};
+    std::atomic<uint64_t> io_requests{0};         // PRINTs enviados ao IOManager
+    std::atomic<uint64_t> io_issued_at{0};        // Relógio do núcleo ao bloquear no último I/O
+    std::atomic<uint64_t> io_ready_at{0};         // Conclusão do último I/O (0 = já contabilizado)
+    std::atomic<uint64_t> io_stall_cycles{0};     // Núcleo parado esperando o I/O ao retomar o processo
+    std::atomic<uint64_t> io_overlap_cycles{0};   // Latência de I/O coberta por trabalho de outros processos
 
     // Métricas de escalonamento (para Round Robin multicore)
     std::atomic<uint64_t> arrival_time{0};      // Quando entrou no sistema
@@ -64,6 +102,9 @@ struct PCB {
     std::atomic<uint64_t> context_switches{0};  // Número de trocas de contexto
     std::atomic<int> assigned_core{-1};         // Núcleo atual (-1 = nenhum)
     std::atomic<int> last_core{-1};             // Último núcleo usado
+    std::atomic<int> l1_core{-1};               // Núcleo cuja L1 guarda as linhas do último quantum
+    std::atomic<uint64_t> l1_warm_lines{0};     // Linhas reaproveitadas ao voltar para o mesmo núcleo
+    std::atomic<uint64_t> l1_lines_peak{0};     // Maior ocupação da L1 ao fim de um quantum
     std::atomic<uint64_t> ready_queue_enter_time{0}; // Timestamp de entrada na fila ready
 
     // Informações do programa carregado
@@ -73,6 +114,16 @@ struct PCB {
     uint32_t segment_base_addr = 0;
     uint32_t segment_limit = 0;
 
+    // Espaço de endereçamento virtual (nulo = endereços físicos, sem memória virtual)
+    std::unique_ptr<AddressSpace> address_space;
+    uint16_t asid = 0;   // Tag do processo na TLB e nas linhas da L1 (0 = ainda sem ASID)
+    // Partição da L2 (CAT): classe de serviço e máscara de vias pedidas no JSON.
+    // Sem classe e com máscara, o processo ganha uma classe só dele.
+    int cache_class = -1;      // -1 = classe 0 (todas as vias)
+    uint32_t cache_mask = 0;   // 0 = máscara atual da classe
+    // Distância de reuso dos acessos (curva de miss); nulo sem --mrc
+    std::unique_ptr<ReuseProfiler> reuse_profile;
+
     // Flags de falha e razão (compatibilidade com API antiga)
     std::atomic<bool> failed{false};
     std::string fail_reason;
@@ -112,6 +163,23 @@ struct PCB {
         if (hits + misses == 0) return 0.0;
         return (double)hits / (hits + misses);
     }
+
+    double get_prefetch_accuracy() const {
+        uint64_t issued = prefetch_issued.load();
+        return issued > 0 ? (double)prefetch_hits.load() / issued : 0.0;
+    }
+
+    double get_prefetch_coverage() const {
+        uint64_t useful = prefetch_hits.load();
+        uint64_t total = useful + cache_misses.load();
+        return total > 0 ? (double)useful / total : 0.0;
+    }
+
+    double get_tlb_hit_rate() const {
+        uint64_t hits = tlb_hits.load();
+        uint64_t total = hits + tlb_misses.load();
+        return total > 0 ? (double)hits / total : 0.0;
+    }
     // Compatibilidade: métodos esperados por testes antigos
     void mark_failed(const std::string &reason);
     void set_state(State s);
@@ -126,6 +194,15 @@ inline void contabiliza_cache(PCB &pcb, bool hit) {
     }
 }
 
+// Contabilizar a classe (3C) de um miss da L1
+inline void contabiliza_miss(PCB &pcb, MissClass kind) {
+    switch (kind) {
+        case MissClass::Compulsory: pcb.miss_compulsory++; break;
+        case MissClass::Capacity:   pcb.miss_capacity++; break;
+        default:                    pcb.miss_conflict++; break;
+    }
+}
+
 // Implementações inline dos métodos de compatibilidade
 inline void PCB::mark_failed(const std::string &reason) {
     failed.store(true);
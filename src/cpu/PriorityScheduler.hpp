@@ -23,6 +23,7 @@
 #include <mutex>
 #include "PCB.hpp"
 #include "Core.hpp"
+#include "IOCompletionQueue.hpp"
 #include "../IO/IOManager.hpp"
 #include "memory/MemoryManager.hpp"
 #include "Constants.hpp"
@@ -70,6 +71,9 @@ private:
     std::deque<PCB*> ready_queue;  // Ordenada por prioridade (maior primeiro)
     std::vector<PCB*> blocked_list;
     std::vector<PCB*> finished_list;
+
+    // Processos com I/O concluído, empilhados pelo IOManager sem trava
+    IOCompletionQueue io_completions;
     
     // CRITICAL: Atomics para evitar race conditions (igual ao RoundRobin)
     std::atomic<int> finished_count{0};
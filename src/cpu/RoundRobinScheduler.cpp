@@ -20,7 +20,8 @@ RoundRobinScheduler::RoundRobinScheduler(int num_cores,
 {
 
     for (int i = 0; i < num_cores; ++i) {
-        cores.push_back(std::make_unique<Core>(i, memory_manager));
+        cores.push_back(std::make_unique<Core>(i, memory_manager, io_manager,
+            [this](PCB* process) { io_completions.push(process); }));
         cores[i]->reset_metrics();
     }
     total_simulation_cycles.store(0);
@@ -42,6 +43,8 @@ RoundRobinScheduler::~RoundRobinScheduler() {
             core->wait_completion();
         }
     }
+    // Callbacks de I/O ainda a caminho apontam para este escalonador
+    if (io_manager) io_manager->waitForCompletions();
     
     // Limpar filas
     std::lock_guard<std::mutex> lock(scheduler_mutex);
@@ -107,6 +110,8 @@ void RoundRobinScheduler::schedule_cycle() {
                             old_process->finish_time = cpu_time::now_ns();
                             finished_list.push_back(old_process);
                             finished_count.fetch_add(1);
+                        } else if (old_process->state == State::Blocked) {
+                            blocked_queue.push_back(old_process);
                         } else if (old_process->state == State::Ready) {
                             enqueue_ready_process(old_process);
                         }
@@ -248,14 +253,12 @@ void RoundRobinScheduler::drain_cores() {
 }
 
 
+// Bloqueados só voltam quando o IOManager entrega a conclusão
 void RoundRobinScheduler::handle_blocked_processes() {
-    if (blocked_queue.empty()) return;
-    while (!blocked_queue.empty()) {
-        PCB* p = blocked_queue.front();
-        blocked_queue.pop_front();
-        p->state = State::Ready;
-        enqueue_ready_process(p);
-    }
+    io_completions.release(blocked_queue, [this](PCB* process) {
+        process->state = State::Ready;
+        enqueue_ready_process(process);
+    });
 }
 
 void RoundRobinScheduler::enqueue_ready_process(PCB* process) {
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include "Core.hpp"
 #include "PCB.hpp"
+#include "IOCompletionQueue.hpp"
 
 // Forward declarations for managers
 class MemoryManager;
@@ -42,6 +43,7 @@ public:
     int get_failed_count() const { return failed_count.load(); }
     int get_total_count() const { return total_count.load(); }
     Statistics get_statistics() const;
+    std::vector<std::unique_ptr<Core>>& get_cores() { return cores; }
 
 private:
     std::vector<std::unique_ptr<Core>> cores;
@@ -49,6 +51,9 @@ private:
     std::deque<PCB*> blocked_queue;
     std::vector<PCB*> finished_list;
 
+    // Processos com I/O concluído, empilhados pelo IOManager sem trava
+    IOCompletionQueue io_completions;
+
     int num_cores{0};
     int default_quantum{100};
 
@@ -17,6 +17,14 @@ bool load_pcb_from_json(const std::string &path, PCB &pcb) {
         pcb.name = j.value("name", std::string(""));
         pcb.quantum = j.value("quantum", 0);
         pcb.priority = j.value("priority", 0);
+        // Partição da L2: "cache_class": 2 e/ou "cache_mask": "0x0f" (ou número)
+        pcb.cache_class = j.value("cache_class", -1);
+        if (j.contains("cache_mask")) {
+            const auto &mask = j["cache_mask"];
+            pcb.cache_mask = mask.is_string()
+                ? static_cast<uint32_t>(std::stoul(mask.get<std::string>(), nullptr, 0))
+                : mask.get<uint32_t>();
+        }
         if (j.contains("mem_weights")) {
             auto &mw = j["mem_weights"];
             pcb.memWeights.primary = mw.value("primary", 1ULL);
@@ -1,11 +1,14 @@
 #include <iostream>
 #include <vector>
 #include <deque>
+#include <map>
 #include <memory>
 #include <thread>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <algorithm>
+#include <cctype>
 
 #include "memory/MemoryManager.hpp"
 #include "cpu/PCB.hpp"
@@ -30,7 +33,67 @@ void print_metrics(const PCB& pcb) {
     std::cout << "  - Leituras:             " << pcb.mem_reads.load() << "\n";
     std::cout << "  - Escritas:             " << pcb.mem_writes.load() << "\n";
     std::cout << "Acessos a Cache L1:     " << pcb.cache_mem_accesses.load() << "\n";
+    std::cout << "  - Hits / Misses:        " << pcb.cache_hits.load() << " / " << pcb.cache_misses.load() << "\n";
+    std::cout << "  - Misses Comp/Cap/Conf: " << pcb.miss_compulsory.load() << " / " << pcb.miss_capacity.load()
+              << " / " << pcb.miss_conflict.load() << "\n";
+    std::cout << "  - Ocupacao (pico):      " << pcb.l1_lines_peak.load() << " linhas ("
+              << pcb.l1_warm_lines.load() << " reaproveitadas na volta ao nucleo)\n";
+    std::cout << "  - Prefetches (uteis):   " << pcb.prefetch_issued.load() << " (" << pcb.prefetch_hits.load() << ")\n";
+    std::cout << "  - Precisao/Cobertura:   " << pcb.get_prefetch_accuracy() * 100.0 << "% / "
+              << pcb.get_prefetch_coverage() * 100.0 << "%\n";
+    if (pcb.ifetch_accesses > 0) {
+        std::cout << "Buscas de Instrucao:    " << pcb.ifetch_accesses.load() << " ("
+                  << pcb.fetch_buffer_hits.load() << " no buffer de busca, "
+                  << pcb.fetch_cycles.load() << " ciclos)\n";
+        std::cout << "  - L1I Hits / Misses:    " << pcb.ifetch_hits.load() << " / " << pcb.ifetch_misses.load() << "\n";
+    }
+    if (pcb.l2_hits + pcb.l2_misses > 0) {
+        std::cout << "L2 Hits / Misses:       " << pcb.l2_hits.load() << " / " << pcb.l2_misses.load()
+                  << " (classe " << std::max(0, pcb.cache_class) << ")\n";
+    }
+    if (pcb.address_space) {
+        std::cout << "TLB Hits / Misses:      " << pcb.tlb_hits.load() << " / " << pcb.tlb_misses.load()
+                  << " (walk: " << pcb.page_walk_cycles.load() << " ciclos, "
+                  << pcb.address_space->mappedPages() << " paginas na RAM)\n";
+        std::cout << "Faltas de Pagina:       " << pcb.page_faults.load()
+                  << " (servico: " << pcb.fault_service_cycles.load() << " ciclos, "
+                  << pcb.cow_copies.load() << " copias COW)\n";
+    }
+    if (pcb.dram_row_hits + pcb.dram_row_misses + pcb.dram_row_conflicts > 0) {
+        std::cout << "DRAM Hit/Miss/Conflito: " << pcb.dram_row_hits.load() << " / " << pcb.dram_row_misses.load()
+                  << " / " << pcb.dram_row_conflicts.load()
+                  << " (fila: " << pcb.dram_queue_cycles.load() << " ciclos)\n";
+    }
+    if (pcb.bus_transfers > 0) {
+        std::cout << "Barramento:             " << pcb.bus_transfers.load() << " transferencias"
+                  << " (espera: " << pcb.bus_queue_cycles.load() << " ciclos)\n";
+    }
+    if (pcb.noc_cycles > 0) {
+        std::cout << "Rede-em-chip:           " << pcb.noc_cycles.load() << " ciclos"
+                  << " (espera: " << pcb.noc_wait_cycles.load() << " ciclos)\n";
+    }
+    if (pcb.io_requests > 0) {
+        std::cout << "I/O:                    " << pcb.io_requests.load() << " pedidos, "
+                  << pcb.io_cycles.load() << " ciclos bloqueado (sobrepostos: "
+                  << pcb.io_overlap_cycles.load() << ", parado: " << pcb.io_stall_cycles.load() << ")\n";
+    }
+    if (pcb.reuse_profile && pcb.reuse_profile->sampled() > 0) {
+        // Resumo da curva: tamanhos da L1 (em linhas) de 4 em 4x
+        std::cout << "Curva de Miss (LRU):    ";
+        for (size_t lines = 4; lines <= 1024; lines *= 4) {
+            std::cout << lines << "L " << pcb.reuse_profile->missRatio(lines) * 100.0 << "%  ";
+        }
+        std::cout << "\n";
+    }
+    if (pcb.mlp_overlap_cycles + pcb.store_forwards + pcb.mshr_merges > 0) {
+        std::cout << "Latencia Sobreposta:    " << pcb.mlp_overlap_cycles.load() << " ciclos ("
+                  << pcb.store_forwards.load() << " forwards do store buffer, "
+                  << pcb.mshr_merges.load() << " acessos juntados a MSHRs)\n";
+    }
     std::cout << "Acessos a Mem Principal:" << pcb.primary_mem_accesses.load() << "\n";
+    if (pcb.remote_mem_accesses > 0) {
+        std::cout << "  - Remotos (NUMA):       " << pcb.remote_mem_accesses.load() << "\n";
+    }
     std::cout << "Acessos a Mem Secundaria:" << pcb.secondary_mem_accesses.load() << "\n";
     std::cout << "Ciclos Totais de Memoria: " << pcb.memory_cycles.load() << "\n";
     std::cout << "------------------------------------------\n";
@@ -51,7 +114,63 @@ void print_metrics(const PCB& pcb) {
         resultados << "Ciclos de Memória: " << pcb.memory_cycles << "\n";
         resultados << "Cache Hits: " << pcb.cache_hits << "\n";
         resultados << "Cache Misses: " << pcb.cache_misses << "\n";
+        resultados << "Misses Compulsorios: " << pcb.miss_compulsory << "\n";
+        resultados << "Misses de Capacidade: " << pcb.miss_capacity << "\n";
+        resultados << "Misses de Conflito: " << pcb.miss_conflict << "\n";
+        resultados << "Ocupacao de L1 (pico): " << pcb.l1_lines_peak << "\n";
+        resultados << "Linhas de L1 Reaproveitadas: " << pcb.l1_warm_lines << "\n";
+        resultados << "Prefetches Emitidos: " << pcb.prefetch_issued << "\n";
+        resultados << "Prefetches Uteis: " << pcb.prefetch_hits << "\n";
+        resultados << "Precisao de Prefetch: " << pcb.get_prefetch_accuracy() * 100.0 << "%\n";
+        resultados << "Cobertura de Prefetch: " << pcb.get_prefetch_coverage() * 100.0 << "%\n";
+        if (pcb.ifetch_accesses > 0) {
+            resultados << "Buscas de Instrucao: " << pcb.ifetch_accesses << "\n";
+            resultados << "Hits no Buffer de Busca: " << pcb.fetch_buffer_hits << "\n";
+            resultados << "L1I Hits: " << pcb.ifetch_hits << "\n";
+            resultados << "L1I Misses: " << pcb.ifetch_misses << "\n";
+            resultados << "Ciclos de Busca: " << pcb.fetch_cycles << "\n";
+        }
+        if (pcb.l2_hits + pcb.l2_misses > 0) {
+            resultados << "Classe da L2: " << std::max(0, pcb.cache_class) << "\n";
+            resultados << "L2 Hits: " << pcb.l2_hits << "\n";
+            resultados << "L2 Misses: " << pcb.l2_misses << "\n";
+        }
+        if (pcb.address_space) {
+            resultados << "TLB Hits: " << pcb.tlb_hits << "\n";
+            resultados << "TLB Misses: " << pcb.tlb_misses << "\n";
+            resultados << "Ciclos de Page Walk: " << pcb.page_walk_cycles << "\n";
+            resultados << "Faltas de Pagina: " << pcb.page_faults << "\n";
+            resultados << "Ciclos de Servico de Faltas: " << pcb.fault_service_cycles << "\n";
+            resultados << "Copias COW: " << pcb.cow_copies << "\n";
+        }
+        if (pcb.dram_row_hits + pcb.dram_row_misses + pcb.dram_row_conflicts > 0) {
+            resultados << "DRAM Row Hits: " << pcb.dram_row_hits << "\n";
+            resultados << "DRAM Row Misses: " << pcb.dram_row_misses << "\n";
+            resultados << "DRAM Row Conflitos: " << pcb.dram_row_conflicts << "\n";
+            resultados << "Ciclos de Fila na DRAM: " << pcb.dram_queue_cycles << "\n";
+        }
+        if (pcb.bus_transfers > 0) {
+            resultados << "Transferencias no Barramento: " << pcb.bus_transfers << "\n";
+            resultados << "Ciclos de Espera no Barramento: " << pcb.bus_queue_cycles << "\n";
+        }
+        if (pcb.noc_cycles > 0) {
+            resultados << "Ciclos na NoC: " << pcb.noc_cycles << "\n";
+            resultados << "Ciclos de Espera na NoC: " << pcb.noc_wait_cycles << "\n";
+        }
+        if (pcb.remote_mem_accesses > 0) {
+            resultados << "Acessos Remotos (NUMA): " << pcb.remote_mem_accesses << "\n";
+        }
+        if (pcb.mlp_overlap_cycles + pcb.store_forwards + pcb.mshr_merges > 0) {
+            resultados << "Ciclos de Latencia Sobreposta: " << pcb.mlp_overlap_cycles << "\n";
+            resultados << "Forwards do Store Buffer: " << pcb.store_forwards << "\n";
+            resultados << "Acessos Juntados a MSHRs: " << pcb.mshr_merges << "\n";
+        }
         resultados << "Ciclos de IO: " << pcb.io_cycles << "\n";
+        if (pcb.io_requests > 0) {
+            resultados << "Pedidos de IO: " << pcb.io_requests << "\n";
+            resultados << "Ciclos de IO Sobrepostos: " << pcb.io_overlap_cycles << "\n";
+            resultados << "Ciclos Parado Esperando IO: " << pcb.io_stall_cycles << "\n";
+        }
     }
 
 
@@ -93,6 +212,24 @@ void print_metrics(const PCB& pcb) {
 }
 
 
+// Converte tamanhos como "4096", "64K", "16M" ou "1G" (em palavras)
+size_t parse_size(const std::string& text) {
+    if (text.empty()) return 0;
+    size_t multiplier = 1;
+    std::string digits = text;
+    switch (std::toupper(static_cast<unsigned char>(text.back()))) {
+        case 'K': multiplier = 1ull << 10; digits.pop_back(); break;
+        case 'M': multiplier = 1ull << 20; digits.pop_back(); break;
+        case 'G': multiplier = 1ull << 30; digits.pop_back(); break;
+        default: break;
+    }
+    try {
+        return static_cast<size_t>(std::stoull(digits)) * multiplier;
+    } catch (...) {
+        return 0;
+    }
+}
+
 void print_help() {
     std::cout << "===========================================\n";
     std::cout << "  SIMULADOR VON NEUMANN MULTICORE\n";
@@ -115,6 +252,66 @@ void print_help() {
     std::cout << "                          PCB: arquivo JSON com metadados do processo\n";
     std::cout << "                          Pode ser usado múltiplas vezes\n";
     std::cout << "                          Exemplo: --process tasks.json process1.json\n\n";
+    std::cout << "  --cache-line NUM        Endereços por linha da cache L1 (padrão: " << CACHE_LINE_SIZE << ")\n";
+    std::cout << "                          Cada miss traz a linha inteira em um acesso\n\n";
+    std::cout << "  --prefetch POLÍTICA     Prefetcher da L1: none, next, stride (padrão: none)\n";
+    std::cout << "  --prefetch-degree NUM   Linhas buscadas por disparo do prefetcher (padrão: 1)\n";
+    std::cout << "  --l1i-lines NUM         Linhas da L1 de instruções de cada núcleo; 0 = L1 unificada,\n";
+    std::cout << "                          busca e dados na mesma cache (padrão: " << CACHE_CAPACITY << ")\n";
+    std::cout << "  --fetch-buffer NUM      Linhas do buffer de busca à frente da L1I (padrão: " << FETCH_BUFFER_LINES << ")\n\n";
+    std::cout << "  --l2-lines NUM          Linhas da L2 compartilhada pelos núcleos (padrão: 0 = sem L2)\n";
+    std::cout << "  --l2-ways NUM           Vias da L2, até " << L2_MAX_WAYS << " (padrão: 8)\n";
+    std::cout << "  --l2-latency NUM        Ciclos de um hit na L2 (padrão: 3)\n";
+    std::cout << "  --l2-class K=MÁSCARA    Vias da classe de serviço K (0-" << L2_MAX_CLASSES - 1
+              << "), ex.: --l2-class 1=0x0f\n";
+    std::cout << "                          O PCB escolhe a classe com \"cache_class\" e/ou \"cache_mask\"\n";
+    std::cout << "  --l2-ucp NUM            Refaz as máscaras das classes ativas a cada NUM acessos à L2\n";
+    std::cout << "                          pela utilidade medida (UCP); 0 = máscaras fixas (padrão)\n\n";
+    std::cout << "  --store-buffer NUM      Entradas do store buffer de cada núcleo; SW não espera a\n";
+    std::cout << "                          escrita e LW da mesma palavra recebe o dado dele (padrão: 0)\n";
+    std::cout << "  --mshrs NUM             Misses de LW em andamento por núcleo; o pipeline só espera\n";
+    std::cout << "                          quando uma instrução lê o registrador (padrão: 0 = bloqueante)\n\n";
+    std::cout << "  --ram-size TAM          Capacidade da RAM em palavras, aceita K/M/G (padrão: 1M)\n";
+    std::cout << "  --disk-size TAM         Capacidade do disco em palavras, aceita K/M/G (padrão: 4M)\n";
+    std::cout << "  --ram-mmap              Reserva a RAM com mmap (MAP_NORESERVE) em vez do heap\n";
+    std::cout << "  --disk-file ARQUIVO     Disco em arquivo esparso mapeado (persiste entre execuções)\n";
+    std::cout << "  --disk-latency F[,P]    Ciclos extras por acesso ao disco: fixo F + P por página\n";
+    std::cout << "                          Exemplo: --disk-latency 50,8 (padrão: 0,0)\n";
+    std::cout << "  --io-latency D=B[,J[,T]] Latência de I/O do dispositivo D (printer, disk, network) em\n";
+    std::cout << "                          ciclos simulados: B + uniforme[0,J] + exponencial de média T\n";
+    std::cout << "                          (padrão: printer=2000,1000 disk=500,4000 network=1000,0,2000)\n\n";
+    std::cout << "  --dram                  Modela a RAM como DRAM (bancos, row buffer, fila FR-FCFS)\n";
+    std::cout << "                          em vez do custo fixo memWeights.primary\n";
+    std::cout << "  --dram-channels NUM     Canais da DRAM (padrão: 1)\n";
+    std::cout << "  --dram-banks NUM        Bancos por canal (padrão: 8)\n";
+    std::cout << "  --dram-row TAM          Endereços por linha de banco, aceita K/M (padrão: 1K)\n";
+    std::cout << "  --dram-policy POLÍTICA  Row buffer: open, closed (padrão: open)\n";
+    std::cout << "  --dram-timing H,M,C     Ciclos de row hit, miss e conflito (padrão: 2,5,9)\n\n";
+    std::cout << "  --bus-width NUM         Barramento compartilhado até a RAM com NUM palavras por ciclo;\n";
+    std::cout << "                          a espera pelo árbitro entra em memory_cycles (padrão: 0 = sem)\n";
+    std::cout << "  --bus-arbitration POL   Árbitro do barramento: rr, priority, age (padrão: rr)\n\n";
+    std::cout << "  --noc TOPOLOGIA         Rede-em-chip entre núcleos, bancos da L2 e controladores de\n";
+    std::cout << "                          memória: ring, mesh (padrão: desativada)\n";
+    std::cout << "  --noc-hop NUM           Ciclos por salto (padrão: 1)\n";
+    std::cout << "  --noc-width NUM         Palavras por ciclo em cada enlace (padrão: 4)\n";
+    std::cout << "  --noc-mcs NUM           Controladores de memória na rede (padrão: 1)\n\n";
+    std::cout << "  --numa-nodes NUM        Divide a RAM e os núcleos em NUM nós NUMA (padrão: 1)\n";
+    std::cout << "  --numa-remote NUM       Ciclos extras por acesso à RAM de outro nó (padrão: 0)\n";
+    std::cout << "  --numa-cores LISTA      Nó de cada núcleo, ex.: 0,0,1,1 (padrão: blocos contíguos)\n\n";
+    std::cout << "  --vm                    Ativa memória virtual (tabela de páginas por processo + TLB)\n";
+    std::cout << "                          com paginação por demanda: a RAM vira quadros e o disco, swap\n";
+    std::cout << "                          Cada processo é carregado no endereço virtual 0\n";
+    std::cout << "                          Processos do mesmo programa compartilham a imagem (copy-on-write)\n";
+    std::cout << "  --no-cow                Carrega uma cópia da imagem por processo, mesmo com --vm\n";
+    std::cout << "  --page-policy POLÍTICA  Substituição de páginas: fifo, clock, wsclock, aging (padrão: fifo)\n";
+    std::cout << "  --ws-window NUM         Janela do WSClock em acessos do processo (padrão: " << DEFAULT_WS_WINDOW << ")\n";
+    std::cout << "  --tlb-entries NUM       Entradas da TLB de cada núcleo (padrão: 64)\n";
+    std::cout << "  --tlb-ways NUM          Associatividade da TLB, 0 = total (padrão: 4)\n\n";
+    std::cout << "  --trace ARQUIVO         Grava o trace binário dos acessos (PC, endereço, R/W, PID, núcleo)\n";
+    std::cout << "                          para reprodução offline com bin/cachesim\n";
+    std::cout << "  --mrc                   Mede a distância de reuso de cada processo e grava as curvas\n";
+    std::cout << "                          de miss em logs/miss_ratio_curves.csv\n";
+    std::cout << "  --mrc-sample NUM        Amostra 1 de cada NUM linhas nas curvas (padrão: " << REUSE_DEFAULT_SAMPLE << ")\n\n";
     std::cout << "POLÍTICAS DE ESCALONAMENTO:\n";
     std::cout << "  RR        - Round Robin (preemptivo com quantum)\n";
     std::cout << "  FCFS      - First Come First Served (não preemptivo)\n";
@@ -124,6 +321,7 @@ void print_help() {
     std::cout << "  output/resultados.dat           - Métricas de execução\n";
     std::cout << "  output/output.dat               - Saída lógica do programa\n";
     std::cout << "  logs/memory_utilization.csv     - Utilização de memória\n";
+    std::cout << "  logs/miss_ratio_curves.csv      - Curvas de miss por processo (--mrc)\n";
     std::cout << "  logs/multicore_results.csv      - Resultados multicore (testes)\n";
     std::cout << "  logs/throughput_results.csv     - Métricas de throughput (testes)\n\n";
     std::cout << "EXEMPLOS:\n";
@@ -157,6 +355,30 @@ int main(int argc, char* argv[]) {
     int NUM_CORES = 2;
     int DEFAULT_QUANTUM = 100;
     std::string SCHED_POLICY = "RR";
+    CacheConfig l1_config;
+    CacheConfig l1i_config;
+    size_t FETCH_BUFFER = FETCH_BUFFER_LINES;
+    SharedCacheConfig l2_config;
+    std::vector<std::pair<int, uint32_t>> l2_class_masks;
+    size_t RAM_SIZE = MAIN_MEMORY_SIZE;
+    size_t DISK_SIZE = SECONDARY_MEMORY_SIZE;
+    SparseBacking RAM_BACKING = SparseBacking::Heap;
+    std::string DISK_FILE;
+    std::string TRACE_FILE;
+    uint32_t MRC_SAMPLE = 0;   // 0 = sem curvas de miss
+    DiskLatency disk_latency;
+    bool VIRTUAL_MEMORY = false;
+    bool SHARE_IMAGES = true;
+    TLBConfig tlb_config;
+    PageReplacementPolicy PAGE_POLICY = PageReplacementPolicy::FIFO;
+    uint64_t WS_WINDOW = DEFAULT_WS_WINDOW;
+    bool DRAM_MODEL = false;
+    NumaConfig numa_config;
+    DramConfig dram_config;
+    BusConfig bus_config;
+    std::vector<std::pair<IODevice, IODeviceModel>> io_models;
+    NocConfig noc_config;
+    LsuConfig lsu_config;
     // Parse de argumentos
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -166,8 +388,143 @@ int main(int argc, char* argv[]) {
             if (i + 1 < argc) DEFAULT_QUANTUM = std::atoi(argv[++i]);
         } else if (arg == "--policy" || arg == "-s") {
             if (i + 1 < argc) SCHED_POLICY = argv[++i];
+        } else if (arg == "--cache-line") {
+            if (i + 1 < argc) l1_config.line_size = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--prefetch") {
+            if (i + 1 < argc) l1_config.prefetch = Prefetcher::parsePolicy(argv[++i]);
+        } else if (arg == "--prefetch-degree") {
+            if (i + 1 < argc) l1_config.prefetch_degree = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--l1i-lines") {
+            if (i + 1 < argc) l1i_config.lines = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--fetch-buffer") {
+            if (i + 1 < argc) FETCH_BUFFER = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--l2-lines") {
+            if (i + 1 < argc) l2_config.lines = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--l2-ways") {
+            if (i + 1 < argc) l2_config.ways = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--l2-latency") {
+            if (i + 1 < argc) l2_config.latency = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--l2-ucp") {
+            if (i + 1 < argc) l2_config.rebalance_interval = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--l2-class") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                size_t equals = value.find('=');
+                if (equals != std::string::npos) {
+                    l2_class_masks.emplace_back(std::atoi(value.substr(0, equals).c_str()),
+                                                static_cast<uint32_t>(std::stoul(value.substr(equals + 1), nullptr, 0)));
+                }
+            }
+        } else if (arg == "--store-buffer") {
+            if (i + 1 < argc) lsu_config.store_buffer = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--mshrs") {
+            if (i + 1 < argc) lsu_config.mshrs = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--ram-size") {
+            if (i + 1 < argc) RAM_SIZE = parse_size(argv[++i]);
+        } else if (arg == "--disk-size") {
+            if (i + 1 < argc) DISK_SIZE = parse_size(argv[++i]);
+        } else if (arg == "--ram-mmap") {
+            RAM_BACKING = SparseBacking::Mmap;
+        } else if (arg == "--vm") {
+            VIRTUAL_MEMORY = true;
+        } else if (arg == "--no-cow") {
+            SHARE_IMAGES = false;
+        } else if (arg == "--page-policy") {
+            if (i + 1 < argc) PAGE_POLICY = PageReplacer::parsePolicy(argv[++i]);
+        } else if (arg == "--ws-window") {
+            if (i + 1 < argc) WS_WINDOW = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--tlb-entries") {
+            if (i + 1 < argc) tlb_config.entries = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--tlb-ways") {
+            if (i + 1 < argc) tlb_config.ways = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--dram") {
+            DRAM_MODEL = true;
+        } else if (arg == "--dram-channels") {
+            if (i + 1 < argc) dram_config.channels = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--dram-banks") {
+            if (i + 1 < argc) dram_config.banks = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--dram-row") {
+            if (i + 1 < argc) dram_config.row_words = std::max<size_t>(1, parse_size(argv[++i]));
+        } else if (arg == "--dram-policy") {
+            if (i + 1 < argc) dram_config.policy = DramModel::parsePolicy(argv[++i]);
+        } else if (arg == "--dram-timing") {
+            if (i + 1 < argc) {
+                uint64_t* timings[] = {&dram_config.t_hit, &dram_config.t_miss, &dram_config.t_conflict};
+                std::string value = argv[++i];
+                size_t start = 0;
+                for (uint64_t* timing : timings) {
+                    if (start > value.size()) break;
+                    size_t comma = value.find(',', start);
+                    *timing = std::strtoull(value.substr(start, comma - start).c_str(), nullptr, 10);
+                    start = (comma == std::string::npos) ? value.size() + 1 : comma + 1;
+                }
+            }
+        } else if (arg == "--bus-width") {
+            if (i + 1 < argc) bus_config.width = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--bus-arbitration") {
+            if (i + 1 < argc) bus_config.arbitration = MemoryBus::parseArbitration(argv[++i]);
+        } else if (arg == "--noc") {
+            if (i + 1 < argc) noc_config.topology = Interconnect::parseTopology(argv[++i]);
+        } else if (arg == "--noc-hop") {
+            if (i + 1 < argc) noc_config.hop_latency = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--noc-width") {
+            if (i + 1 < argc) noc_config.link_width = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--noc-mcs") {
+            if (i + 1 < argc) noc_config.memory_controllers = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--numa-nodes") {
+            if (i + 1 < argc) numa_config.nodes = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--numa-remote") {
+            if (i + 1 < argc) numa_config.remote_latency = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--numa-cores") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                size_t start = 0;
+                while (start <= value.size()) {
+                    size_t comma = value.find(',', start);
+                    if (comma == std::string::npos) comma = value.size();
+                    numa_config.core_nodes.push_back(std::atoi(value.substr(start, comma - start).c_str()));
+                    start = comma + 1;
+                }
+            }
+        } else if (arg == "--disk-file") {
+            if (i + 1 < argc) DISK_FILE = argv[++i];
+        } else if (arg == "--trace") {
+            if (i + 1 < argc) TRACE_FILE = argv[++i];
+        } else if (arg == "--mrc") {
+            if (MRC_SAMPLE == 0) MRC_SAMPLE = REUSE_DEFAULT_SAMPLE;
+        } else if (arg == "--mrc-sample") {
+            if (i + 1 < argc) MRC_SAMPLE = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--disk-latency") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                size_t comma = value.find(',');
+                disk_latency.fixed = std::strtoull(value.substr(0, comma).c_str(), nullptr, 10);
+                if (comma != std::string::npos) {
+                    disk_latency.per_page = std::strtoull(value.substr(comma + 1).c_str(), nullptr, 10);
+                }
+            }
+        } else if (arg == "--io-latency") {
+            if (i + 1 < argc) {
+                std::string value = argv[++i];
+                size_t equals = value.find('=');
+                IODevice device;
+                if (equals != std::string::npos && IOManager::parseDevice(value.substr(0, equals), device)) {
+                    IODeviceModel model;
+                    std::string numbers = value.substr(equals + 1);
+                    size_t first = numbers.find(',');
+                    size_t second = first == std::string::npos ? first : numbers.find(',', first + 1);
+                    model.base = std::strtoull(numbers.substr(0, first).c_str(), nullptr, 10);
+                    if (first != std::string::npos) {
+                        model.jitter = std::strtoull(numbers.substr(first + 1, second - first - 1).c_str(), nullptr, 10);
+                    }
+                    if (second != std::string::npos) model.tail_mean = std::atof(numbers.substr(second + 1).c_str());
+                    io_models.emplace_back(device, model);
+                }
+            }
         }
     }
+    l1i_config.line_size = l1_config.line_size;   // Mesmas linhas nos dois lados (cópia entre L1 e L1I)
+    l2_config.line_size = l1_config.line_size;
     std::cout << "===========================================\n";
     std::cout << "  SIMULADOR MULTICORE\n";
     std::cout << "===========================================\n";
@@ -180,10 +537,109 @@ int main(int argc, char* argv[]) {
     else std::cout << "Round Robin";
     std::cout << "\n";
     if (SCHED_POLICY == "RR") std::cout << "  - Quantum: " << DEFAULT_QUANTUM << " ciclos\n";
+    std::cout << "  - Cache L1: " << l1_config.lines << " linhas x " << l1_config.line_size
+              << " endereços, prefetch " << Prefetcher::policyName(l1_config.prefetch) << "\n";
+    if (l1i_config.lines > 0) {
+        std::cout << "  - Cache L1I: " << l1i_config.lines << " linhas, buffer de busca de "
+                  << FETCH_BUFFER << " linha(s)\n";
+    } else {
+        std::cout << "  - Cache L1I: unificada com a L1 de dados\n";
+    }
+    if (l2_config.enabled()) {
+        std::cout << "  - Cache L2 compartilhada: " << l2_config.lines << " linhas, "
+                  << std::min<size_t>(l2_config.ways, L2_MAX_WAYS) << " vias, hit de "
+                  << l2_config.latency << " ciclos, particionamento "
+                  << (l2_config.rebalance_interval > 0
+                          ? "por utilidade a cada " + std::to_string(l2_config.rebalance_interval) + " acessos"
+                          : std::string("fixo"))
+                  << "\n";
+    }
+    if (lsu_config.enabled()) {
+        std::cout << "  - Load/store: store buffer de " << lsu_config.store_buffer << " entradas, "
+                  << lsu_config.mshrs << " MSHRs por núcleo\n";
+    }
+    std::cout << "  - Memória: RAM " << RAM_SIZE << " palavras"
+              << (RAM_BACKING == SparseBacking::Mmap ? " (mmap)" : "")
+              << ", disco " << DISK_SIZE << " palavras"
+              << (DISK_FILE.empty() ? "" : " em '" + DISK_FILE + "'") << "\n";
+    std::cout << "  - Latência de I/O (ciclos simulados, base + jitter + cauda):";
+    for (size_t d = 0; d < IO_DEVICE_COUNT; ++d) {
+        IODeviceModel model = IOManager::defaultModel(static_cast<IODevice>(d));
+        for (const auto& [device, custom] : io_models) {
+            if (device == static_cast<IODevice>(d)) model = custom;
+        }
+        std::cout << " " << IOManager::deviceName(static_cast<IODevice>(d)) << "=" << model.base << "+"
+                  << model.jitter << "+" << model.tail_mean;
+    }
+    std::cout << "\n";
+    std::cout << "  - Latência do disco: +" << disk_latency.fixed << " ciclos fixos, +"
+              << disk_latency.per_page << " por página\n";
+    if (DRAM_MODEL) {
+        std::cout << "  - DRAM: " << dram_config.channels << " canal(is) x " << dram_config.banks
+                  << " bancos, linhas de " << dram_config.row_words << " endereços, página "
+                  << DramModel::policyName(dram_config.policy) << ", hit/miss/conflito "
+                  << dram_config.t_hit << "/" << dram_config.t_miss << "/" << dram_config.t_conflict << " ciclos\n";
+    }
+    if (bus_config.enabled()) {
+        std::cout << "  - Barramento: " << bus_config.width << " palavra(s) por ciclo, árbitro "
+                  << MemoryBus::arbitrationName(bus_config.arbitration) << "\n";
+    }
+    if (noc_config.enabled()) {
+        std::cout << "  - NoC: " << Interconnect::topologyName(noc_config.topology) << " com "
+                  << NUM_CORES << " tiles, " << noc_config.hop_latency << " ciclo(s) por salto, enlaces de "
+                  << noc_config.link_width << " palavra(s)/ciclo, " << noc_config.memory_controllers
+                  << " controlador(es) de memória\n";
+    }
+    if (numa_config.nodes > 1) {
+        std::cout << "  - NUMA: " << numa_config.nodes << " nós, +" << numa_config.remote_latency
+                  << " ciclos por acesso remoto\n";
+    }
+    if (VIRTUAL_MEMORY) {
+        std::cout << "  - Memória virtual: páginas de " << VM_PAGE_SIZE << " endereços, TLB "
+                  << tlb_config.entries << " entradas / "
+                  << (tlb_config.ways == 0 ? std::string("totalmente associativa")
+                                           : std::to_string(tlb_config.ways) + " vias") << "\n";
+        std::cout << "  - Paginação por demanda: " << RAM_SIZE / VM_PAGE_SIZE << " quadros, substituição "
+                  << PageReplacer::policyName(PAGE_POLICY) << "\n";
+        std::cout << "  - Imagens iguais: " << (SHARE_IMAGES ? "compartilhadas (copy-on-write)" : "uma cópia por processo") << "\n";
+    }
+    if (MRC_SAMPLE > 0) {
+        std::cout << "  - Curvas de miss: distância de reuso amostrada (1 de cada " << MRC_SAMPLE << " linhas)\n";
+    }
     std::cout << "===========================================\n\n";
+    // Endereços são de 32 bits: RAM + disco precisam caber nesse espaço
+    if (RAM_SIZE == 0 || RAM_SIZE + DISK_SIZE > (1ull << 32)) {
+        std::cerr << "Capacidade de memória inválida (RAM + disco deve estar entre 1 e 4G palavras).\n";
+        return 1;
+    }
     // Inicialização dos módulos
-    MemoryManager memManager(1024, 8192);
+    MemoryManager memManager(RAM_SIZE, DISK_SIZE, RAM_BACKING, DISK_FILE);
+    memManager.setL1Config(l1_config);
+    memManager.setL1IConfig(l1i_config);
+    memManager.setFetchBufferLines(FETCH_BUFFER);
+    memManager.setLsuConfig(lsu_config);
+    memManager.setDiskLatency(disk_latency);
+    if (DRAM_MODEL) memManager.enableDram(dram_config);
+    if (bus_config.enabled()) memManager.enableBus(bus_config);
+    if (noc_config.enabled()) memManager.enableInterconnect(noc_config, NUM_CORES);
+    if (l2_config.enabled()) {
+        memManager.enableSharedCache(l2_config);
+        for (const auto& [clos, mask] : l2_class_masks) {
+            memManager.getSharedCache()->setMask(clos, mask);
+            memManager.reserveCacheClass(clos);
+        }
+    }
+    try {
+        if (numa_config.nodes > 1) memManager.enableNuma(numa_config, NUM_CORES);
+        if (VIRTUAL_MEMORY) memManager.enableVirtualMemory(tlb_config, PAGE_POLICY, WS_WINDOW);
+        if (!TRACE_FILE.empty()) memManager.enableTrace(TRACE_FILE);
+        if (MRC_SAMPLE > 0) memManager.enableReuseProfiling(MRC_SAMPLE);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
     IOManager ioManager;
+    for (const auto& [device, model] : io_models) ioManager.setDeviceModel(device, model);
     MemoryMetrics memMetrics("logs/memory_utilization.csv");
     // Escolha do escalonador
     std::unique_ptr<RoundRobinScheduler> rr_sched;
@@ -217,9 +673,96 @@ int main(int argc, char* argv[]) {
     if (process_files.empty()) {
         process_files.push_back({"examples/programs/tasks.json", "examples/processes/process1.json"});
     }
-    uint32_t next_base_address = 0;
-    for (size_t i = 0; i < process_files.size(); i++) {
-        const auto& [program_file, pcb_file] = process_files[i];
+    // A imagem já está carregada: o perfil de reuso só vê os acessos do programa
+    auto add_to_scheduler = [&](PCB* pcb) {
+        memManager.attachReuseProfiler(*pcb);
+        memManager.assignCacheClass(*pcb);
+        if (SCHED_POLICY == "FCFS") fcfs_sched->add_process(pcb);
+        else if (SCHED_POLICY == "SJN") sjn_sched->add_process(pcb);
+        else if (SCHED_POLICY == "PRIORITY") priority_sched->add_process(pcb);
+        else rr_sched->add_process(pcb);
+    };
+    // Tenta o caminho informado e, se falhar, a raiz do projeto
+    auto load_program = [&](PCB& pcb, const std::string& program_file, uint32_t base_address) {
+        try {
+            loadJsonProgram(program_file, memManager, pcb, base_address);
+        } catch (...) {
+            std::filesystem::path prog_path_alt = std::filesystem::path(program_file).filename();
+            try {
+                loadJsonProgram(prog_path_alt.string(), memManager, pcb, base_address);
+            } catch (...) {
+                return false;
+            }
+        }
+        // Estimativa: usar tamanho do programa como proxy de job size
+        pcb.estimated_job_size = pcb.program_size;
+        return true;
+    };
+    auto measure_program = [&](const std::string& program_file) {
+        try {
+            return measureJsonProgram(program_file);
+        } catch (...) {
+            std::filesystem::path prog_path_alt = std::filesystem::path(program_file).filename();
+            try {
+                return measureJsonProgram(prog_path_alt.string());
+            } catch (...) {
+                return -1;
+            }
+        }
+    };
+    // Sem memória virtual cada imagem recebe um segmento do alocador (preferindo o nó
+    // NUMA do processo); quem não cabe na RAM espera até outro processo terminar
+    struct PendingLoad {
+        PCB* pcb;
+        std::string program_file;
+        size_t words;
+        int node;
+    };
+    std::deque<PendingLoad> pending_loads;
+    // Com memória virtual: primeiro processo de cada programa (dono da imagem compartilhada)
+    std::map<std::string, PCB*> loaded_images;
+    size_t admitted = 0;
+    // Pior fragmentação externa observada com segmentos vivos (no fim tudo foi devolvido)
+    FragmentationReport peak_fragmentation;
+    // Programa de um processo admitido não pôde ser lido: main encerra com erro
+    bool load_failed = false;
+    auto admit = [&](const PendingLoad& load, bool allow_disk) {
+        const uint32_t base_address = memManager.allocateSegment(load.words, load.node, allow_disk);
+        if (base_address == SEGMENT_UNAVAILABLE) return false;
+        if (!VIRTUAL_MEMORY) {
+            const FragmentationReport current = memManager.getFragmentation();
+            if (current.segments > 0 && current.external_pct() >= peak_fragmentation.external_pct()) {
+                peak_fragmentation = current;
+            }
+        }
+        if (!load_program(*load.pcb, load.program_file, base_address)) {
+            std::cerr << "Erro ao carregar '" << load.program_file << "'.\n";
+            load_failed = true;
+            return false;
+        }
+        load.pcb->segment_base_addr = base_address;
+        load.pcb->segment_limit = static_cast<uint32_t>(load.words);
+        add_to_scheduler(load.pcb);
+        ++admitted;
+        return true;
+    };
+    auto all_finished = [&]() {
+        if (SCHED_POLICY == "FCFS") return fcfs_sched->all_finished();
+        if (SCHED_POLICY == "SJN") return sjn_sched->all_finished();
+        if (SCHED_POLICY == "PRIORITY") return priority_sched->all_finished();
+        return !rr_sched->has_pending_processes();
+    };
+    // Admite em ordem de chegada; o disco só é usado se nada estiver rodando
+    // (imagem maior que a RAM livre mesmo com todos os segmentos devolvidos)
+    auto admit_pending = [&]() {
+        while (!pending_loads.empty()) {
+            if (!admit(pending_loads.front(), all_finished())) break;
+            pending_loads.pop_front();
+        }
+    };
+    // PCBs primeiro: as classes da L2 pedidas explicitamente ficam reservadas antes de
+    // algum processo receber uma classe própria
+    for (const auto& [program_file, pcb_file] : process_files) {
         auto pcb = std::make_unique<PCB>();
         bool loaded_pcb = load_pcb_from_json(pcb_file, *pcb);
         if (!loaded_pcb) {
@@ -231,32 +774,51 @@ int main(int argc, char* argv[]) {
             std::cerr << "Erro ao carregar '" << pcb_file << "'.\n";
             return 1;
         }
-        // Tenta carregar o programa (tasks.json) no caminho informado, se falhar tenta na raiz
-        bool loaded_prog = true;
-        try {
-            loadJsonProgram(program_file, memManager, *pcb, next_base_address);
-        } catch (...) {
-            std::filesystem::path prog_path_alt = std::filesystem::path(program_file).filename();
-            try {
-                loadJsonProgram(prog_path_alt.string(), memManager, *pcb, next_base_address);
-            } catch (...) {
-                loaded_prog = false;
-            }
-        }
-        if (!loaded_prog) {
-            std::cerr << "Erro ao carregar '" << program_file << "'.\n";
-            return 1;
-        }
         pcb->arrival_time = 0;
-        // Estimativa: usar tamanho do programa como proxy de job size
-        pcb->estimated_job_size = pcb->program_size;
-        next_base_address += 1024;
-        if (SCHED_POLICY == "FCFS") fcfs_sched->add_process(pcb.get());
-        else if (SCHED_POLICY == "SJN") sjn_sched->add_process(pcb.get());
-        else if (SCHED_POLICY == "PRIORITY") priority_sched->add_process(pcb.get());
-        else rr_sched->add_process(pcb.get());
+        memManager.reserveCacheClass(pcb->cache_class);
         process_list.push_back(std::move(pcb));
     }
+    for (size_t i = 0; i < process_files.size(); i++) {
+        const std::string& program_file = process_files[i].first;
+        PCB* pcb = process_list[i].get();
+        if (VIRTUAL_MEMORY) {
+            // Com memória virtual cada processo tem seu próprio espaço e começa no endereço 0
+            memManager.attachAddressSpace(*pcb);
+            auto image = loaded_images.find(program_file);
+            if (image != loaded_images.end() && memManager.shareImage(*image->second, *pcb)) {
+                // Mesmo programa já carregado: usa as páginas dele (copy-on-write)
+                pcb->regBank.pc.write(pcb->program_start_addr);
+                pcb->estimated_job_size = pcb->program_size;
+            } else {
+                if (!load_program(*pcb, program_file, 0)) {
+                    std::cerr << "Erro ao carregar '" << program_file << "'.\n";
+                    return 1;
+                }
+                if (SHARE_IMAGES) loaded_images.emplace(program_file, pcb);
+            }
+            add_to_scheduler(pcb);
+        } else {
+            const int words = measure_program(program_file);
+            if (words < 0) {
+                std::cerr << "Erro ao carregar '" << program_file << "'.\n";
+                return 1;
+            }
+            memManager.assignAsid(*pcb);
+            const int node = static_cast<int>(i % memManager.getNumaNodes());
+            PendingLoad load{pcb, program_file, static_cast<size_t>(words), node};
+            if (!pending_loads.empty() || !admit(load, admitted == 0)) {
+                if (load_failed) return 1;
+                if (admitted == 0) {
+                    std::cerr << "Memória insuficiente para carregar '" << program_file << "'.\n";
+                    return 1;
+                }
+                pending_loads.push_back(load);
+            }
+        }
+    }
+    if (!pending_loads.empty()) {
+        std::cout << "  - " << pending_loads.size() << " processo(s) aguardando segmento livre na RAM\n";
+    }
     // std::cout << "✓ " << process_list.size() << " processo(s) carregado(s)\n\n";
     // Loop principal
     std::cout << "\n===========================================\n";
@@ -271,34 +833,111 @@ int main(int argc, char* argv[]) {
         );
     };
     if (SCHED_POLICY == "FCFS") {
-        while (!fcfs_sched->all_finished()) {
+        while (!fcfs_sched->all_finished() || !pending_loads.empty()) {
             fcfs_sched->schedule_cycle();
+            admit_pending();
+            if (load_failed) break;
             record_mem();
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
     } else if (SCHED_POLICY == "SJN") {
-        while (!sjn_sched->all_finished()) {
+        while (!sjn_sched->all_finished() || !pending_loads.empty()) {
             sjn_sched->schedule_cycle();
+            admit_pending();
+            if (load_failed) break;
             record_mem();
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
     } else if (SCHED_POLICY == "PRIORITY") {
-        while (!priority_sched->all_finished()) {
+        while (!priority_sched->all_finished() || !pending_loads.empty()) {
             priority_sched->schedule_cycle();
+            admit_pending();
+            if (load_failed) break;
             record_mem();
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
     } else {
-        while (rr_sched->has_pending_processes()) {
+        while (rr_sched->has_pending_processes() || !pending_loads.empty()) {
             rr_sched->schedule_cycle();
+            admit_pending();
+            if (load_failed) break;
             record_mem();
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
     }
+    if (load_failed) return 1;
+    for (const auto& process : process_list) {
+        if (!process->reuse_profile) continue;
+        MissRatioCurve curve = process->reuse_profile->curve();
+        curve.pid = process->pid;
+        curve.name = process->name;
+        memMetrics.recordMissRatioCurve(curve);
+    }
+    std::vector<std::unique_ptr<Core>>& cores =
+        SCHED_POLICY == "FCFS" ? fcfs_sched->get_cores() :
+        SCHED_POLICY == "SJN" ? sjn_sched->get_cores() :
+        SCHED_POLICY == "PRIORITY" ? priority_sched->get_cores() : rr_sched->get_cores();
+    for (const auto& core : cores) {
+        memMetrics.recordCacheSets(core->get_id(), core->get_l1_cache().setStats());
+    }
     memMetrics.flush();
     std::cout << "\n===========================================\n";
     std::cout << "Todos os processos foram finalizados!\n";
     std::cout << "===========================================\n\n";
+    std::cout << "Misses da L1 por nucleo (compulsorio / capacidade / conflito):\n";
+    for (const auto& core : cores) {
+        const CacheSetStats total = core->get_l1_cache().totals();
+        std::cout << "  - Core " << core->get_id() << ": " << total.misses << " de " << total.accesses
+                  << " acessos (" << total.compulsory << " / " << total.capacity << " / " << total.conflict << ")\n";
+    }
+    for (const auto& core : cores) {
+        const Cache* l1i = core->get_l1i_cache();
+        if (!l1i) continue;
+        const CacheSetStats total = l1i->totals();
+        std::cout << "  - Core " << core->get_id() << " (L1I): " << total.misses << " de " << total.accesses
+                  << " acessos (" << total.compulsory << " / " << total.capacity << " / " << total.conflict << ")\n";
+    }
+    if (const SharedCache* l2 = memManager.getSharedCache()) {
+        std::cout << "Cache L2 por classe (" << l2->rebalances() << " reparticoes):\n";
+        for (const SharedCacheClassStats& stats : l2->classStats()) {
+            std::cout << "  - Classe " << stats.clos << ": mascara 0x" << std::hex << stats.mask << std::dec
+                      << ", " << stats.misses << " misses de " << stats.accesses << " acessos, "
+                      << stats.occupancy << " linhas ocupadas\n";
+        }
+    }
+    if (const MemoryBus* bus = memManager.getBus()) {
+        const MemoryStats stats = MemoryManager::getStats();
+        const uint64_t elapsed = std::max<uint64_t>(bus->clock(), 1);
+        std::cout << "Barramento (" << MemoryBus::arbitrationName(bus->getConfig().arbitration) << "): "
+                  << stats.bus_transfers << " transferencias, " << stats.bus_queue_cycles
+                  << " ciclos de espera, ocupado "
+                  << std::min(100.0, bus->busyCycles() * 100.0 / elapsed) << "% do tempo simulado\n";
+    }
+    if (const Interconnect* noc = memManager.getInterconnect()) {
+        const MemoryStats stats = MemoryManager::getStats();
+        std::cout << "NoC (" << Interconnect::topologyName(noc->getConfig().topology) << ", "
+                  << noc->routers() << " roteadores): " << stats.noc_messages << " mensagens, "
+                  << (stats.noc_messages > 0 ? double(stats.noc_hops) / stats.noc_messages : 0.0)
+                  << " saltos em média, " << stats.noc_wait_cycles << " ciclos de espera nos enlaces\n";
+    }
+    std::cout << "Acessos por conjunto gravados em '" << memMetrics.get_sets_file() << "'\n\n";
+    if (MRC_SAMPLE > 0) {
+        std::cout << "Curvas de miss gravadas em '" << memMetrics.get_curve_file() << "'\n\n";
+    }
+    if (memManager.getTrace()) {
+        std::cout << "Trace: " << memManager.getTrace()->records() << " acessos gravados em '"
+                  << memManager.getTrace()->getPath() << "'\n\n";
+    }
+    if (!VIRTUAL_MEMORY) {
+        const FragmentationReport final_fragmentation = memManager.getFragmentation();
+        std::cout << "Segmentos da RAM (buddy):\n";
+        std::cout << "  - Pico: " << peak_fragmentation.segments << " segmento(s), "
+                  << peak_fragmentation.internal_pct() << "% interna, "
+                  << peak_fragmentation.external_pct() << "% externa, maior bloco livre "
+                  << peak_fragmentation.largest_free << "\n";
+        std::cout << "  - Final: " << final_fragmentation.free << "/" << final_fragmentation.capacity
+                  << " livres, maior bloco livre " << final_fragmentation.largest_free << "\n\n";
+    }
     // Exibir métricas individuais
     for (const auto& process : process_list) {
         if (process->state == State::Finished) {
@@ -0,0 +1,34 @@
+#include "AddressSpace.hpp"
+
+AddressSpace::AddressSpace(uint16_t asid) : asid(asid), directory(TABLE_ENTRIES) {}
+
+PageTableEntry* AddressSpace::find(uint32_t vpn) {
+    const size_t dir = (vpn >> PT_LEVEL_BITS) % TABLE_ENTRIES;
+    Table* table = directory[dir].get();
+    if (!table) return nullptr;
+    return &(*table)[vpn & (TABLE_ENTRIES - 1)];
+}
+
+PageTableEntry& AddressSpace::entry(uint32_t vpn) {
+    const size_t dir = (vpn >> PT_LEVEL_BITS) % TABLE_ENTRIES;
+    if (!directory[dir]) {
+        directory[dir] = std::make_unique<Table>();
+    }
+    return (*directory[dir])[vpn & (TABLE_ENTRIES - 1)];
+}
+
+PageTableEntry& AddressSpace::map(uint32_t vpn, uint32_t frame) {
+    PageTableEntry& pte = entry(vpn);
+    if (!pte.present) ++mapped;
+    pte.frame = frame;
+    pte.referenced = false;
+    pte.dirty = false;
+    pte.present = true;
+    return pte;
+}
+
+void AddressSpace::unmap(PageTableEntry& pte) {
+    if (!pte.present) return;
+    pte.present = false;
+    --mapped;
+}
@@ -0,0 +1,78 @@
+#ifndef ADDRESS_SPACE_HPP
+#define ADDRESS_SPACE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "SparseMemory.hpp"
+
+#define VM_PAGE_SIZE SPARSE_PAGE_WORDS  // Endereços por página virtual (igual à página física)
+#define PT_LEVEL_BITS 11                // Bits do VPN por nível (22 bits de VPN = 2 níveis)
+#define NO_SWAP_SLOT UINT32_MAX
+
+// Os bits P/R/M são atômicos: o núcleo dono os marca a cada acesso enquanto
+// outro núcleo pode varrê-los ao escolher uma vítima
+struct PageTableEntry {
+    uint32_t frame = 0;                   // Quadro físico na RAM
+    uint32_t swap_slot = NO_SWAP_SLOT;    // Cópia da página no disco (swap)
+    std::atomic<bool> present{false};     // Página em um quadro da RAM
+    std::atomic<bool> referenced{false};  // Bit R (acessada desde a última varredura)
+    std::atomic<bool> dirty{false};       // Bit M (difere da cópia no swap)
+    std::atomic<bool> cow{false};         // Página compartilhada: a primeira escrita faz uma cópia privada
+};
+
+/**
+ * AddressSpace - Espaço de endereçamento virtual de um processo
+ *
+ * Tabela de páginas de dois níveis indexada pelo VPN (endereço / VM_PAGE_SIZE).
+ * As tabelas de segundo nível só são criadas quando alguma página delas é mapeada.
+ * Cada espaço tem um ASID, usado como tag nas entradas da TLB.
+ * Com paginação por demanda uma página pode estar na RAM (present) ou só no swap.
+ */
+class AddressSpace {
+public:
+    static constexpr unsigned LEVELS = 2;
+    static constexpr size_t TABLE_ENTRIES = size_t(1) << PT_LEVEL_BITS;
+
+    explicit AddressSpace(uint16_t asid);
+
+    uint16_t getAsid() const { return asid; }
+    size_t mappedPages() const { return mapped; }  // Páginas residentes na RAM
+
+    // Processo em execução em algum núcleo (suas páginas não podem ser despejadas)
+    bool isRunning() const { return running; }
+    void setRunning(bool value) { running = value; }
+
+    // Tempo virtual: acessos traduzidos deste espaço (só o núcleo dono incrementa)
+    uint64_t virtualTime() const { return vtime.load(std::memory_order_relaxed); }
+    void tick() { vtime.fetch_add(1, std::memory_order_relaxed); }
+
+    static uint32_t pageOf(uint32_t vaddr) { return vaddr / VM_PAGE_SIZE; }
+    static uint32_t offsetOf(uint32_t vaddr) { return vaddr % VM_PAGE_SIZE; }
+
+    // Percorre a tabela; nulo se o segundo nível ainda não existe
+    PageTableEntry* find(uint32_t vpn);
+
+    // PTE de `vpn`, criando o segundo nível se preciso (sem mapear a página)
+    PageTableEntry& entry(uint32_t vpn);
+
+    // Mapeia `vpn` no quadro `frame`, criando o segundo nível se preciso
+    PageTableEntry& map(uint32_t vpn, uint32_t frame);
+
+    // Retira a página da RAM (a PTE mantém o slot de swap)
+    void unmap(PageTableEntry& pte);
+
+private:
+    using Table = std::array<PageTableEntry, TABLE_ENTRIES>;
+
+    uint16_t asid;
+    std::vector<std::unique_ptr<Table>> directory;
+    size_t mapped = 0;
+    bool running = false;
+    std::atomic<uint64_t> vtime{0};
+};
+
+#endif
@@ -0,0 +1,81 @@
+#include "BuddyAllocator.hpp"
+#include <algorithm>
+
+void FragmentationReport::merge(const FragmentationReport& other) {
+    capacity += other.capacity;
+    segments += other.segments;
+    requested += other.requested;
+    allocated += other.allocated;
+    free += other.free;
+    largest_free = std::max(largest_free, other.largest_free);
+}
+
+BuddyAllocator::BuddyAllocator(size_t base, size_t size) : base(base), size(size) {
+    unsigned max_order = 0;
+    while (blockSize(max_order + 1) <= size) ++max_order;
+    free_lists.resize(max_order + 1);
+
+    // Cobre a região com os maiores blocos alinhados (offsets relativos a `base`)
+    size_t offset = 0;
+    while (offset + BUDDY_MIN_BLOCK <= size) {
+        unsigned order = max_order;
+        while (order > 0 && (offset % blockSize(order) != 0 || offset + blockSize(order) > size)) --order;
+        free_lists[order].insert(offset);
+        offset += blockSize(order);
+    }
+}
+
+size_t BuddyAllocator::allocate(size_t words) {
+    unsigned order = 0;
+    while (order < free_lists.size() && blockSize(order) < words) ++order;
+
+    unsigned found = order;
+    while (found < free_lists.size() && free_lists[found].empty()) ++found;
+    if (found >= free_lists.size()) return NO_SEGMENT;
+
+    size_t offset = *free_lists[found].begin();
+    free_lists[found].erase(free_lists[found].begin());
+    // Divide até a ordem pedida; as metades de cima voltam para as listas
+    while (found > order) {
+        --found;
+        free_lists[found].insert(offset + blockSize(found));
+    }
+    segments[offset] = Segment{order, std::max<size_t>(words, 1)};
+    return base + offset;
+}
+
+bool BuddyAllocator::release(size_t address) {
+    if (!owns(address)) return false;
+    auto it = segments.find(address - base);
+    if (it == segments.end()) return false;
+
+    size_t offset = it->first;
+    unsigned order = it->second.order;
+    segments.erase(it);
+
+    while (order + 1 < free_lists.size()) {
+        const size_t buddy = offset ^ blockSize(order);
+        auto found = free_lists[order].find(buddy);
+        if (found == free_lists[order].end()) break;
+        free_lists[order].erase(found);
+        offset = std::min(offset, buddy);
+        ++order;
+    }
+    free_lists[order].insert(offset);
+    return true;
+}
+
+FragmentationReport BuddyAllocator::report() const {
+    FragmentationReport r;
+    r.capacity = size;
+    r.segments = segments.size();
+    for (const auto& entry : segments) {
+        r.requested += entry.second.requested;
+        r.allocated += blockSize(entry.second.order);
+    }
+    for (unsigned order = 0; order < free_lists.size(); ++order) {
+        r.free += free_lists[order].size() * blockSize(order);
+        if (!free_lists[order].empty()) r.largest_free = blockSize(order);
+    }
+    return r;
+}
@@ -0,0 +1,74 @@
+#ifndef BUDDY_ALLOCATOR_HPP
+#define BUDDY_ALLOCATOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#define BUDDY_MIN_BLOCK 64     // Menor bloco, em endereços
+#define NO_SEGMENT SIZE_MAX
+
+/**
+ * Ocupação e fragmentação de uma região gerenciada por alocadores de segmentos
+ */
+struct FragmentationReport {
+    size_t capacity = 0;        // Endereços gerenciados
+    size_t segments = 0;        // Segmentos vivos
+    size_t requested = 0;       // Endereços pedidos pelos segmentos vivos
+    size_t allocated = 0;       // Endereços dos blocos entregues (potências de 2)
+    size_t free = 0;
+    size_t largest_free = 0;
+
+    // Desperdício dentro dos blocos (arredondamento para potência de 2)
+    double internal_pct() const {
+        return allocated > 0 ? (double)(allocated - requested) / allocated * 100.0 : 0.0;
+    }
+    // Memória livre que não está no maior bloco livre
+    double external_pct() const {
+        return free > 0 ? (1.0 - (double)largest_free / free) * 100.0 : 0.0;
+    }
+
+    void merge(const FragmentationReport& other);
+};
+
+/**
+ * BuddyAllocator - Alocador buddy para segmentos de imagens de processos
+ *
+ * Gerencia [base, base + size) em blocos de BUDDY_MIN_BLOCK * 2^k endereços.
+ * Um tamanho que não é potência de 2 é coberto pelos maiores blocos alinhados
+ * que cabem (o resto menor que BUDDY_MIN_BLOCK fica sem uso). Ao liberar, o
+ * bloco é unido ao seu buddy enquanto este também estiver livre.
+ * Não é thread-safe: o MemoryManager serializa as chamadas.
+ */
+class BuddyAllocator {
+public:
+    BuddyAllocator(size_t base, size_t size);
+
+    // Endereço do segmento, ou NO_SEGMENT se nenhum bloco livre comporta `words`
+    size_t allocate(size_t words);
+    // Retorna false se `address` não é o início de um segmento deste alocador
+    bool release(size_t address);
+    bool owns(size_t address) const { return address >= base && address < base + size; }
+
+    FragmentationReport report() const;
+    // Offsets livres de uma ordem (relativos a `base`), para inspeção
+    const std::set<size_t>& freeBlocks(unsigned order) const { return free_lists.at(order); }
+    unsigned maxOrder() const { return static_cast<unsigned>(free_lists.size()) - 1; }
+
+private:
+    struct Segment {
+        unsigned order;
+        size_t requested;
+    };
+
+    size_t base;
+    size_t size;
+    std::vector<std::set<size_t>> free_lists;      // Offsets livres por ordem
+    std::unordered_map<size_t, Segment> segments;  // Offset -> segmento vivo
+
+    static size_t blockSize(unsigned order) { return size_t(BUDDY_MIN_BLOCK) << order; }
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include "DramModel.hpp"
+#include <algorithm>
+#include <cctype>
+
+DramModel::DramModel(const DramConfig& cfg) : config(cfg) {
+    config.channels = std::max<size_t>(config.channels, 1);
+    config.banks = std::max<size_t>(config.banks, 1);
+    config.row_words = std::max<size_t>(config.row_words, 1);
+    config.queue_depth = std::max<size_t>(config.queue_depth, 1);
+    banks.reset(new Bank[config.channels * config.banks]);
+}
+
+DramAccess DramModel::access(uint32_t address, uint64_t now) {
+    // Mapeamento: [linha | banco | canal | coluna]
+    const size_t block = address / config.row_words;
+    const size_t channel = block % config.channels;
+    const size_t bank_in_channel = (block / config.channels) % config.banks;
+    const uint32_t row = static_cast<uint32_t>(block / (config.channels * config.banks));
+    Bank& bank = banks[channel * config.banks + bank_in_channel];
+
+    uint64_t seen = latest.load(std::memory_order_relaxed);
+    while (seen < now && !latest.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {}
+
+    DramAccess result;
+    std::lock_guard<std::mutex> lock(bank.mutex);
+
+    if (config.policy == RowPolicy::Open && bank.open) {
+        result.outcome = (bank.row == row) ? RowOutcome::Hit : RowOutcome::Conflict;
+    } else {
+        result.outcome = RowOutcome::Miss;
+    }
+    switch (result.outcome) {
+        case RowOutcome::Hit:      result.latency = config.t_hit; break;
+        case RowOutcome::Conflict: result.latency = config.t_conflict; break;
+        default:                   result.latency = config.t_miss; break;
+    }
+
+    // FR-FCFS: hit à linha aberta passa à frente dos pedidos que ainda vão trocá-la
+    const bool first_ready = (result.outcome == RowOutcome::Hit && bank.hit_streak < config.hit_streak_cap);
+    uint64_t start = std::max(now, first_ready ? bank.hit_ready_at : bank.ready_at);
+    // A fila do banco tem profundidade limitada: relógios de núcleos muito atrasados
+    // não esperam mais do que uma fila cheia
+    start = std::min(start, now + config.queue_depth * config.t_conflict);
+    const uint64_t finish = start + result.latency;
+
+    if (first_ready && bank.ready_at > start) {
+        bank.ready_at += result.latency;  // Os pedidos passados para trás atrasam
+        ++bank.hit_streak;
+    } else {
+        bank.ready_at = std::max(bank.ready_at, finish);
+        bank.hit_streak = 0;
+    }
+    bank.hit_ready_at = finish;
+    bank.open = (config.policy == RowPolicy::Open);
+    bank.row = row;
+
+    result.queue_delay = start - now;
+    return result;
+}
+
+RowPolicy DramModel::parsePolicy(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return lower == "closed" ? RowPolicy::Closed : RowPolicy::Open;
+}
+
+const char* DramModel::policyName(RowPolicy policy) {
+    return policy == RowPolicy::Closed ? "closed" : "open";
+}
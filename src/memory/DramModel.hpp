@@ -0,0 +1,85 @@
+#ifndef DRAM_MODEL_HPP
+#define DRAM_MODEL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "StripedLock.hpp"
+
+enum class RowPolicy {
+    Open,    // A linha fica aberta no row buffer após o acesso
+    Closed   // Precharge logo após cada acesso (nunca há conflito, nem hit)
+};
+
+enum class RowOutcome {
+    Hit,      // Linha já aberta no banco
+    Miss,     // Banco sem linha aberta: só ativação
+    Conflict  // Outra linha aberta: precharge + ativação
+};
+
+/**
+ * Configuração da DRAM por trás da RAM (latências em ciclos simulados)
+ */
+struct DramConfig {
+    size_t channels = 1;
+    size_t banks = 8;              // Bancos por canal
+    size_t row_words = 1024;       // Endereços por linha (row) de um banco
+    RowPolicy policy = RowPolicy::Open;
+    uint64_t t_hit = 2;
+    uint64_t t_miss = 5;
+    uint64_t t_conflict = 9;
+    size_t queue_depth = 16;       // Fila por banco: limita a espera de um pedido
+    size_t hit_streak_cap = 4;     // FR-FCFS: hits seguidos que podem furar a fila
+};
+
+/**
+ * Resultado de um acesso à DRAM
+ */
+struct DramAccess {
+    RowOutcome outcome = RowOutcome::Miss;
+    uint64_t latency = 0;       // Serviço no banco (hit/miss/conflito)
+    uint64_t queue_delay = 0;   // Espera atrás de pedidos de outros núcleos
+};
+
+/**
+ * DramModel - Modelo de temporização de canais, bancos e row buffers
+ *
+ * O endereço é dividido em blocos de `row_words`, intercalados entre canais e
+ * depois entre bancos. Cada pedido chega no relógio simulado do núcleo que o
+ * emitiu; se o banco ainda está ocupado com pedidos de outros núcleos, espera.
+ * O escalonamento é um FR-FCFS aproximado: um pedido que acerta a linha aberta
+ * é atendido logo após o último hit, à frente dos misses enfileirados, até
+ * `hit_streak_cap` vezes seguidas (evita inanição dos misses).
+ */
+class DramModel {
+public:
+    explicit DramModel(const DramConfig& cfg);
+
+    DramAccess access(uint32_t address, uint64_t now);
+
+    // Maior instante de chegada já visto (relógio de referência da DRAM)
+    uint64_t clock() const { return latest.load(std::memory_order_relaxed); }
+    const DramConfig& getConfig() const { return config; }
+
+    static RowPolicy parsePolicy(const std::string& name);
+    static const char* policyName(RowPolicy policy);
+
+private:
+    struct alignas(HOST_CACHE_LINE_BYTES) Bank {
+        std::mutex mutex;
+        bool open = false;
+        uint32_t row = 0;
+        uint64_t ready_at = 0;      // Fim do último pedido enfileirado
+        uint64_t hit_ready_at = 0;  // Fim do último pedido à linha aberta
+        size_t hit_streak = 0;
+    };
+
+    DramConfig config;
+    std::unique_ptr<Bank[]> banks;
+    std::atomic<uint64_t> latest{0};
+};
+
+#endif
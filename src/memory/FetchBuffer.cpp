@@ -0,0 +1,36 @@
+#include "FetchBuffer.hpp"
+#include <algorithm>
+
+FetchBuffer::FetchBuffer(size_t entries, size_t line_size)
+    : entries(entries), line_size(std::max<size_t>(1, line_size)) {}
+
+bool FetchBuffer::read(uint32_t address, uint32_t& value) const {
+    const uint32_t base = address - static_cast<uint32_t>(address % line_size);
+    for (const Entry& entry : entries) {
+        if (entry.valid && entry.base == base) {
+            value = entry.data[address - base];
+            return true;
+        }
+    }
+    return false;
+}
+
+void FetchBuffer::fill(uint32_t base, const std::vector<uint32_t>& line) {
+    if (entries.empty()) return;
+    Entry& entry = entries[next];
+    entry.valid = true;
+    entry.base = base;
+    entry.data = line;
+    next = (next + 1) % entries.size();
+}
+
+void FetchBuffer::invalidateRange(uint32_t base, size_t size) {
+    for (Entry& entry : entries) {
+        if (entry.valid && entry.base + line_size > base && entry.base < base + size) entry.valid = false;
+    }
+}
+
+void FetchBuffer::clear() {
+    for (Entry& entry : entries) entry.valid = false;
+    next = 0;
+}
@@ -0,0 +1,41 @@
+#ifndef FETCH_BUFFER_HPP
+#define FETCH_BUFFER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#define FETCH_BUFFER_LINES 1   // Linhas guardadas pelo buffer de busca padrão
+
+/**
+ * FetchBuffer - Últimas linhas de instruções lidas da L1I (por núcleo)
+ *
+ * A busca sequencial dentro de uma linha já trazida sai do buffer, sem consultar
+ * a L1I e sem custo de memória. Substituição FIFO; as linhas são cópias, então
+ * escritas e invalidações na faixa precisam descartá-las (invalidateRange).
+ */
+class FetchBuffer {
+public:
+    FetchBuffer(size_t entries, size_t line_size);
+
+    // true se a palavra de `address` está no buffer (devolvida em `value`)
+    bool read(uint32_t address, uint32_t& value) const;
+    void fill(uint32_t base, const std::vector<uint32_t>& line);
+    void invalidateRange(uint32_t base, size_t size);
+    void clear();
+
+    size_t capacity() const { return entries.size(); }
+
+private:
+    struct Entry {
+        bool valid = false;
+        uint32_t base = 0;
+        std::vector<uint32_t> data;
+    };
+
+    std::vector<Entry> entries;
+    size_t line_size;
+    size_t next = 0;   // Próxima entrada a ser substituída
+};
+
+#endif // FETCH_BUFFER_HPP
@@ -0,0 +1,122 @@
+#include "Interconnect.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace {
+enum Port { EAST = 0, WEST = 1, SOUTH = 2, NORTH = 3 };
+}
+
+Interconnect::Interconnect(const NocConfig& cfg, size_t num_tiles)
+    : config(cfg), num_tiles(std::max<size_t>(num_tiles, 1)) {
+    config.link_width = std::max<size_t>(config.link_width, 1);
+    config.memory_controllers = std::max<size_t>(config.memory_controllers, 1);
+    if (config.topology == NocTopology::Mesh) {
+        cols = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(this->num_tiles))));
+        rows = (this->num_tiles + cols - 1) / cols;
+    } else {
+        cols = this->num_tiles;
+        rows = 1;
+    }
+    links.reset(new Link[routers() * 4]);
+}
+
+size_t Interconnect::hops(size_t src, size_t dst) const {
+    if (config.topology == NocTopology::Mesh) {
+        const size_t dx = std::max(src % cols, dst % cols) - std::min(src % cols, dst % cols);
+        const size_t dy = std::max(src / cols, dst / cols) - std::min(src / cols, dst / cols);
+        return dx + dy;
+    }
+    const size_t forward = (dst + cols - src) % cols;
+    return std::min(forward, cols - forward);
+}
+
+size_t Interconnect::controllerTile(size_t controller) const {
+    // Controladores espaçados igualmente entre as posições da rede
+    return (controller % config.memory_controllers) * routers() / config.memory_controllers;
+}
+
+void Interconnect::route(size_t src, size_t dst, std::vector<size_t>& path) const {
+    path.clear();
+    size_t at = src;
+    if (config.topology == NocTopology::Mesh) {
+        // XY: primeiro acerta a coluna, depois a linha (livre de deadlock)
+        while (at % cols != dst % cols) {
+            const bool east = at % cols < dst % cols;
+            path.push_back(at * 4 + (east ? EAST : WEST));
+            at = east ? at + 1 : at - 1;
+        }
+        while (at != dst) {
+            const bool south = at < dst;
+            path.push_back(at * 4 + (south ? SOUTH : NORTH));
+            at = south ? at + cols : at - cols;
+        }
+        return;
+    }
+    const size_t forward = (dst + cols - src) % cols;
+    const bool clockwise = forward <= cols - forward;
+    for (size_t hop = 0, count = clockwise ? forward : cols - forward; hop < count; ++hop) {
+        path.push_back(at * 4 + (clockwise ? EAST : WEST));
+        at = clockwise ? (at + 1) % cols : (at + cols - 1) % cols;
+    }
+}
+
+// Primeiro intervalo livre de `duration` ciclos a partir de `from` (dentro da janela)
+uint64_t Interconnect::reserve(Link& link, uint64_t from, uint64_t duration) {
+    std::lock_guard<std::mutex> lock(link.mutex);
+    uint64_t start = from;
+    while (start + duration <= from + NOC_SLOT_WINDOW) {
+        uint64_t busy = 0;
+        while (busy < duration && link.slots[(start + busy) % NOC_SLOT_WINDOW] != start + busy + 1) ++busy;
+        if (busy == duration) {
+            for (uint64_t cycle = start; cycle < start + duration; ++cycle) {
+                link.slots[cycle % NOC_SLOT_WINDOW] = cycle + 1;
+            }
+            return start;
+        }
+        start += busy + 1;
+    }
+    return start;   // Janela cheia: espera máxima, sem reserva
+}
+
+NocTransfer Interconnect::send(size_t src, size_t dst, size_t words, uint64_t now) {
+    NocTransfer transfer;
+    src %= routers();
+    dst %= routers();
+    if (src == dst) return transfer;   // Mesmo tile: não sai do roteador
+
+    uint64_t seen = latest.load(std::memory_order_relaxed);
+    while (seen < now && !latest.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {}
+
+    thread_local std::vector<size_t> path;
+    route(src, dst, path);
+    const uint64_t serialization = std::min<uint64_t>(
+        (std::max<size_t>(words, 1) + config.link_width - 1) / config.link_width, NOC_SLOT_WINDOW / 2);
+
+    // A cabeça avança um salto por hop_latency; cada enlace fica ocupado pela mensagem inteira
+    uint64_t head = now;
+    for (size_t link : path) {
+        head = reserve(links[link], head, serialization) + config.hop_latency;
+    }
+    transfer.hops = path.size();
+    transfer.cycles = head - now + serialization;
+    transfer.wait = transfer.cycles - (transfer.hops * config.hop_latency + serialization);
+    return transfer;
+}
+
+NocTopology Interconnect::parseTopology(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    if (lower == "ring") return NocTopology::Ring;
+    if (lower == "mesh") return NocTopology::Mesh;
+    return NocTopology::None;
+}
+
+const char* Interconnect::topologyName(NocTopology topology) {
+    switch (topology) {
+        case NocTopology::Ring: return "ring";
+        case NocTopology::Mesh: return "mesh";
+        default:                return "none";
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef INTERCONNECT_HPP
+#define INTERCONNECT_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "StripedLock.hpp"
+
+#define NOC_SLOT_WINDOW 512   // Ciclos à frente reservados por enlace (maior espera possível)
+
+enum class NocTopology {
+    None,
+    Ring,   // Anel bidirecional, menor caminho
+    Mesh    // Malha 2D com roteamento XY
+};
+
+/**
+ * Configuração da rede-em-chip entre núcleos, bancos da L2 e controladores de memória
+ */
+struct NocConfig {
+    NocTopology topology = NocTopology::None;
+    uint64_t hop_latency = 1;       // Ciclos por salto (roteador + enlace)
+    size_t link_width = 4;          // Palavras por ciclo em cada enlace
+    size_t memory_controllers = 1;
+
+    bool enabled() const { return topology != NocTopology::None; }
+};
+
+/**
+ * Resultado do envio de uma mensagem
+ */
+struct NocTransfer {
+    uint64_t cycles = 0;   // Do envio até a chegada da última palavra
+    size_t hops = 0;
+    uint64_t wait = 0;     // Parte de `cycles` esperando enlaces ocupados
+};
+
+/**
+ * Interconnect - Rede-em-chip em anel ou malha 2D
+ *
+ * Cada núcleo fica em um tile com seu banco da L2 (linhas distribuídas entre os
+ * bancos pelo endereço); os controladores de memória ficam espalhados entre as
+ * posições da rede. Uma mensagem de `words` palavras ocupa cada enlace do caminho
+ * por ceil(words / link_width) ciclos e avança um salto a cada `hop_latency`.
+ *
+ * Cada enlace guarda os ciclos já reservados numa janela circular indexada pelo
+ * relógio simulado: a mensagem usa o primeiro intervalo livre a partir da sua
+ * chegada, então núcleos adiantados no tempo não atrasam os que estão atrás.
+ */
+class Interconnect {
+public:
+    Interconnect(const NocConfig& cfg, size_t num_tiles);
+
+    NocTransfer send(size_t src, size_t dst, size_t words, uint64_t now);
+
+    size_t tiles() const { return num_tiles; }
+    size_t routers() const { return cols * rows; }
+    size_t hops(size_t src, size_t dst) const;
+    size_t tileOfCore(int core) const { return static_cast<size_t>(core) % num_tiles; }
+    // Banco da L2 (tile) responsável pela linha
+    size_t bankOf(uint32_t base, size_t line_size) const { return (base / line_size) % num_tiles; }
+    size_t controllerTile(size_t controller) const;
+
+    const NocConfig& getConfig() const { return config; }
+    // Maior instante de envio já visto (relógio de referência da rede)
+    uint64_t clock() const { return latest.load(std::memory_order_relaxed); }
+
+    static NocTopology parseTopology(const std::string& name);
+    static const char* topologyName(NocTopology topology);
+
+private:
+    struct alignas(HOST_CACHE_LINE_BYTES) Link {
+        std::mutex mutex;
+        std::array<uint64_t, NOC_SLOT_WINDOW> slots{};   // Ciclo + 1 de quem reservou (0 = livre)
+    };
+
+    NocConfig config;
+    size_t num_tiles;
+    size_t cols;
+    size_t rows;
+    std::unique_ptr<Link[]> links;   // 4 saídas por roteador (anel usa 2)
+    std::atomic<uint64_t> latest{0};
+
+    void route(size_t src, size_t dst, std::vector<size_t>& path) const;
+    uint64_t reserve(Link& link, uint64_t from, uint64_t duration);
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "LoadStoreUnit.hpp"
+#include <algorithm>
+
+LoadStoreUnit::LoadStoreUnit(const LsuConfig& cfg, size_t line_size)
+    : config(cfg), line_size(std::max<size_t>(1, line_size)) {}
+
+uint64_t LoadStoreUnit::advance(uint64_t now) {
+    cursor = std::max(cursor, now);
+    retire();
+    return cursor;
+}
+
+void LoadStoreUnit::retire() {
+    while (!stores.empty() && stores.front().done_at <= cursor) stores.pop_front();
+    misses.erase(std::remove_if(misses.begin(), misses.end(),
+                                [this](const Pending& miss) { return miss.done_at <= cursor; }),
+                 misses.end());
+}
+
+uint64_t LoadStoreUnit::stallUntil(uint64_t when) {
+    if (when <= cursor) return 0;
+    const uint64_t stall = when - cursor;
+    cursor = when;
+    stats.stalls += stall;
+    retire();
+    return stall;
+}
+
+uint64_t LoadStoreUnit::lineReady(uint32_t line) const {
+    uint64_t done_at = 0;
+    for (const Pending& miss : misses) {
+        if (miss.line == line) done_at = std::max(done_at, miss.done_at);
+    }
+    return done_at;
+}
+
+uint64_t LoadStoreUnit::store(uint32_t address, uint64_t latency, uint64_t now) {
+    advance(now);
+    stats.latency += latency;
+    if (config.store_buffer == 0) return stallUntil(cursor + latency);
+
+    uint64_t stall = 0;
+    if (stores.size() >= config.store_buffer) stall += stallUntil(stores.front().done_at);
+
+    // Drena em ordem: começa quando a escrita anterior terminar
+    const uint64_t start = stores.empty() ? cursor : std::max(cursor, stores.back().done_at);
+    stores.push_back(Pending{address, static_cast<uint32_t>(address / line_size), start + latency});
+    return stall;
+}
+
+uint64_t LoadStoreUnit::load(uint32_t address, uint64_t latency, bool miss, uint64_t now, int dest_register) {
+    advance(now);
+    stats.latency += latency;
+    const uint32_t line = static_cast<uint32_t>(address / line_size);
+
+    uint64_t stall = 0;
+    uint64_t ready_at = cursor + latency;
+    // Store-to-load forwarding: a escrita mais nova da palavra ainda está no buffer
+    const bool forwarded = std::any_of(stores.rbegin(), stores.rend(),
+                                       [address](const Pending& store) { return store.address == address; });
+    if (forwarded) {
+        ++stats.forwards;
+    } else if (const uint64_t line_done = lineReady(line)) {
+        // Linha já a caminho (miss anterior): espera a mesma chegada
+        ++stats.merges;
+        ready_at = std::max(ready_at, line_done);
+    } else if (miss && config.mshrs > 0) {
+        if (misses.size() >= config.mshrs) {
+            const auto oldest = std::min_element(misses.begin(), misses.end(),
+                [](const Pending& a, const Pending& b) { return a.done_at < b.done_at; });
+            stall += stallUntil(oldest->done_at);
+            ready_at = cursor + latency;
+        }
+        misses.push_back(Pending{address, line, ready_at});
+    }
+
+    if (config.mshrs == 0 || dest_register < 0) {
+        return stall + stallUntil(ready_at);
+    }
+    uint64_t& reg = ready[static_cast<size_t>(dest_register) % LSU_REGISTERS];
+    reg = std::max(reg, ready_at);
+    return stall;
+}
+
+uint64_t LoadStoreUnit::waitOperands(const uint32_t* registers, size_t count, uint64_t now) {
+    advance(now);
+    uint64_t needed = 0;
+    for (size_t i = 0; i < count; ++i) needed = std::max(needed, ready[registers[i] % LSU_REGISTERS]);
+    return stallUntil(needed);
+}
+
+uint64_t LoadStoreUnit::drain(uint64_t now) {
+    advance(now);
+    uint64_t last = 0;
+    for (const Pending& store : stores) last = std::max(last, store.done_at);
+    for (const Pending& miss : misses) last = std::max(last, miss.done_at);
+    for (uint64_t reg : ready) last = std::max(last, reg);
+    const uint64_t stall = stallUntil(last);
+    stores.clear();
+    misses.clear();
+    ready.fill(0);
+    return stall;
+}
+
+LsuStats LoadStoreUnit::takeStats() {
+    const LsuStats taken = stats;
+    stats = LsuStats{};
+    return taken;
+}
@@ -0,0 +1,84 @@
+#ifndef LOAD_STORE_UNIT_HPP
+#define LOAD_STORE_UNIT_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#define LSU_REGISTERS 32   // Registradores acompanhados pelo scoreboard
+
+/**
+ * Configuração da unidade de load/store de cada núcleo
+ */
+struct LsuConfig {
+    size_t store_buffer = 0;  // Entradas do store buffer (0 = SW espera a escrita terminar)
+    size_t mshrs = 0;         // Misses de LW simultâneos (0 = LW espera o dado chegar)
+
+    bool enabled() const { return store_buffer > 0 || mshrs > 0; }
+};
+
+/**
+ * Contadores de um quantum (o núcleo soma no PCB ao final)
+ */
+struct LsuStats {
+    uint64_t latency = 0;   // Latência dos acessos que passaram pela unidade
+    uint64_t stalls = 0;    // Ciclos em que o pipeline de fato esperou
+    uint64_t forwards = 0;  // LW servidos pelo store buffer
+    uint64_t merges = 0;    // Acessos juntados a uma linha que já estava a caminho
+};
+
+/**
+ * LoadStoreUnit - Modelo de tempo de um cache não bloqueante (por núcleo)
+ *
+ * Os acessos continuam funcionais e síncronos no MemoryManager; esta unidade só
+ * decide quantos ciclos de cada latência o pipeline precisa esperar:
+ *   - SW entra no store buffer e drena em ordem, em segundo plano; o pipeline só
+ *     para com o buffer cheio. Um LW da mesma palavra recebe o dado do buffer.
+ *   - Um miss de LW ocupa um MSHR e não para o pipeline: o registrador de destino
+ *     fica pendente até a linha chegar e só quem o lê espera (scoreboard). Misses
+ *     independentes se sobrepõem; acessos à mesma linha se juntam ao MSHR dela
+ *     (o store buffer não torna a linha indisponível).
+ * O tempo é o relógio simulado do núcleo; as esperas avançam o cursor interno.
+ */
+class LoadStoreUnit {
+public:
+    LoadStoreUnit(const LsuConfig& cfg, size_t line_size);
+
+    // Retornam os ciclos de espera a cobrar agora (no lugar de `latency`)
+    uint64_t store(uint32_t address, uint64_t latency, uint64_t now);
+    // `dest_register` < 0: leitura bloqueante (busca de instrução, PRINT)
+    uint64_t load(uint32_t address, uint64_t latency, bool miss, uint64_t now, int dest_register);
+    // Espera os operandos de uma instrução que ainda dependem de um LW
+    uint64_t waitOperands(const uint32_t* registers, size_t count, uint64_t now);
+    // Instrução que não é LW escreveu o registrador: o LW antigo não é mais esperado
+    void clearRegister(uint32_t reg) { ready[reg % LSU_REGISTERS] = 0; }
+    // Fim de quantum: espera tudo o que está em andamento e esvazia a unidade
+    uint64_t drain(uint64_t now);
+
+    LsuStats takeStats();
+    const LsuConfig& getConfig() const { return config; }
+
+private:
+    struct Pending {
+        uint32_t address;
+        uint32_t line;
+        uint64_t done_at;
+    };
+
+    LsuConfig config;
+    size_t line_size;
+    std::deque<Pending> stores;     // Ordem de programa
+    std::vector<Pending> misses;    // MSHRs ocupados
+    std::array<uint64_t, LSU_REGISTERS> ready{};
+    uint64_t cursor = 0;
+    LsuStats stats;
+
+    uint64_t advance(uint64_t now);
+    void retire();
+    uint64_t stallUntil(uint64_t when);
+    uint64_t lineReady(uint32_t line) const;   // Chegada do miss da linha (0 se nenhum)
+};
+
+#endif // LOAD_STORE_UNIT_HPP
@@ -3,9 +3,10 @@
 
 #include <cstdint>
 #include <vector>
+#include "SparseMemory.hpp"
 
 #define MEMORY_ACCESS_ERROR UINT32_MAX
-#define MAX_MEMORY_SIZE 1024
+#define DEFAULT_MAIN_MEMORY_SIZE (1u << 20)  // 1 Mi palavras (4 MiB)
 
 using std::size_t;
 using std::uint32_t;
@@ -15,18 +16,20 @@ class MAIN_MEMORY
 {
 private:
     size_t size;
-    vector<uint32_t> ram;
+    SparseMemory ram;
     bool notFull();
     bool isEmpty();
 
 public:
-    MAIN_MEMORY(size_t size);
+    MAIN_MEMORY(size_t size, SparseBacking backing = SparseBacking::Heap);
     ~MAIN_MEMORY();
     uint32_t ReadMem(uint32_t address);
     uint32_t WriteMem(uint32_t address, uint32_t data);
     uint32_t DeleteData(uint32_t address);
 
-    const std::vector<uint32_t>& getRam() const { return ram; }
+    size_t getSize() const { return size; }
+    size_t getUsed() const { return ram.usedWords(); }
+    const SparseMemory& getRam() const { return ram; }
 };
 
 #endif
\ No newline at end of file
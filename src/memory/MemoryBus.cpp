@@ -0,0 +1,103 @@
+#include "MemoryBus.hpp"
+#include <algorithm>
+#include <cctype>
+
+MemoryBus::MemoryBus(const BusConfig& cfg) : config(cfg) {
+    config.width = std::max<size_t>(config.width, 1);
+    transfers.reserve(BUS_QUEUE_DEPTH + 1);
+}
+
+BusGrant MemoryBus::request(int requester, int priority, size_t words, uint64_t now) {
+    BusGrant grant;
+    grant.transfer = (std::max<size_t>(words, 1) + config.width - 1) / config.width;
+    busy.fetch_add(grant.transfer, std::memory_order_relaxed);
+
+    uint64_t seen = latest.load(std::memory_order_relaxed);
+    while (seen < now && !latest.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {}
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Transferências que já começaram em `now` ficam onde estão; as outras voltam ao árbitro
+    uint64_t free_at = now;
+    int last_granted = -1;
+    std::vector<Transfer> pending;
+    size_t fixed = 0;
+    for (const Transfer& transfer : transfers) {
+        if (transfer.start <= now) {
+            free_at = std::max(free_at, transfer.start + transfer.duration);
+            last_granted = transfer.requester;
+            transfers[fixed++] = transfer;
+        } else {
+            pending.push_back(transfer);
+        }
+    }
+    transfers.resize(fixed);
+    const uint64_t seq = next_seq++;
+    pending.push_back(Transfer{requester, priority, now, seq, grant.transfer, 0});
+
+    // A cada liberação do barramento, vence a política entre os pedidos já chegados
+    uint64_t t = free_at;
+    while (!pending.empty()) {
+        auto best = pending.end();
+        uint64_t next_arrival = UINT64_MAX;
+        for (auto it = pending.begin(); it != pending.end(); ++it) {
+            if (it->arrival > t) {
+                next_arrival = std::min(next_arrival, it->arrival);
+                continue;
+            }
+            if (best == pending.end() || wins(*it, *best, last_granted)) best = it;
+        }
+        if (best == pending.end()) {
+            t = next_arrival;   // Barramento ocioso até o próximo pedido
+            continue;
+        }
+        best->start = t;
+        t += best->duration;
+        last_granted = best->requester;
+        if (best->seq == seq) grant.queue_delay = best->start - now;
+        transfers.push_back(*best);
+        pending.erase(best);
+    }
+
+    if (transfers.size() > BUS_QUEUE_DEPTH) {
+        transfers.erase(transfers.begin(), transfers.end() - BUS_QUEUE_DEPTH);
+    }
+    return grant;
+}
+
+bool MemoryBus::wins(const Transfer& a, const Transfer& b, int last_granted) const {
+    switch (config.arbitration) {
+        case BusArbitration::Priority:
+            if (a.priority != b.priority) return a.priority > b.priority;
+            break;
+        case BusArbitration::RoundRobin: {
+            // Distância, em ordem circular de núcleos, a partir do último atendido
+            auto rank = [last_granted](int r) {
+                return r > last_granted ? int64_t(r) - last_granted : int64_t(r) - last_granted + INT32_MAX;
+            };
+            if (rank(a.requester) != rank(b.requester)) return rank(a.requester) < rank(b.requester);
+            break;
+        }
+        default:
+            break;
+    }
+    if (a.arrival != b.arrival) return a.arrival < b.arrival;
+    return a.seq < b.seq;
+}
+
+BusArbitration MemoryBus::parseArbitration(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    if (lower == "priority") return BusArbitration::Priority;
+    if (lower == "age") return BusArbitration::Age;
+    return BusArbitration::RoundRobin;
+}
+
+const char* MemoryBus::arbitrationName(BusArbitration arbitration) {
+    switch (arbitration) {
+        case BusArbitration::Priority: return "priority";
+        case BusArbitration::Age:      return "age";
+        default:                       return "rr";
+    }
+}
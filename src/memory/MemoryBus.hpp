@@ -0,0 +1,83 @@
+#ifndef MEMORY_BUS_HPP
+#define MEMORY_BUS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define BUS_QUEUE_DEPTH 16   // Transferências pendentes que o árbitro ainda pode reordenar
+
+enum class BusArbitration {
+    RoundRobin,  // Próximo núcleo depois do último atendido
+    Priority,    // Maior prioridade do processo primeiro
+    Age          // Pedido mais antigo (no relógio simulado) primeiro
+};
+
+/**
+ * Configuração do barramento entre os núcleos e a RAM
+ */
+struct BusConfig {
+    size_t width = 0;      // Palavras por ciclo (0 = sem barramento modelado)
+    BusArbitration arbitration = BusArbitration::RoundRobin;
+
+    bool enabled() const { return width > 0; }
+};
+
+/**
+ * Resultado de um pedido ao barramento
+ */
+struct BusGrant {
+    uint64_t transfer = 0;      // Ciclos ocupando o barramento
+    uint64_t queue_delay = 0;   // Espera até o árbitro conceder o barramento
+};
+
+/**
+ * MemoryBus - Barramento compartilhado com largura de banda e árbitro
+ *
+ * Cada transferência ocupa ceil(palavras / width) ciclos. Os pedidos chegam no
+ * relógio simulado do núcleo que os emitiu; os que ainda não começaram naquele
+ * instante formam a fila do árbitro, que é refeita a cada pedido: sempre que o
+ * barramento fica livre, entre os pedidos já chegados vence o escolhido pela
+ * política. Pedidos de núcleos adiantados no tempo não atrasam os de núcleos
+ * atrasados, só disputam com eles o mesmo intervalo simulado.
+ */
+class MemoryBus {
+public:
+    explicit MemoryBus(const BusConfig& cfg);
+
+    // requester: núcleo (-1 fora dos núcleos); priority: do processo, maior vence
+    BusGrant request(int requester, int priority, size_t words, uint64_t now);
+
+    // Maior instante de chegada já visto (relógio de referência do barramento)
+    uint64_t clock() const { return latest.load(std::memory_order_relaxed); }
+    uint64_t busyCycles() const { return busy.load(std::memory_order_relaxed); }
+    const BusConfig& getConfig() const { return config; }
+
+    static BusArbitration parseArbitration(const std::string& name);
+    static const char* arbitrationName(BusArbitration arbitration);
+
+private:
+    struct Transfer {
+        int requester;
+        int priority;
+        uint64_t arrival;
+        uint64_t seq;        // Ordem de chegada ao host (desempate)
+        uint64_t duration;
+        uint64_t start;
+    };
+
+    BusConfig config;
+    std::mutex mutex;
+    std::vector<Transfer> transfers;   // Mais recentes, em ordem de concessão
+    uint64_t next_seq = 0;
+    std::atomic<uint64_t> latest{0};
+    std::atomic<uint64_t> busy{0};
+
+    // true se `a` deve ser atendido antes de `b` com o barramento livre
+    bool wins(const Transfer& a, const Transfer& b, int last_granted) const;
+};
+
+#endif
@@ -2,25 +2,15 @@
 #include <algorithm>
 
 uint64_t MemoryManager::getUsedMainMemory() const {
-    uint64_t used = 0;
-    const auto& ram = mainMemory->getRam();
-    for (size_t i = 0; i < ram.size(); ++i) {
-        if (ram[i] != MEMORY_ACCESS_ERROR) ++used;
-    }
-    return used;
+    return mainMemory->getUsed();
 }
 
 uint64_t MemoryManager::getUsedSecondaryMemory() const {
-    uint64_t used = 0;
-    const auto& storage = secondaryMemory->getStorage();
-    for (size_t i = 0; i < storage.size(); ++i) {
-        if (storage[i] != MEMORY_ACCESS_ERROR) ++used;
-    }
-    return used;
+    return secondaryMemory->getUsed();
 }
 
 size_t MemoryManager::getSecondaryMemoryCapacity() const {
-    return secondaryMemory->getStorage().size();
+    return secondaryMemory->getSize();
 }
 #include "MemoryManager.hpp"
 #include "cache.hpp"
@@ -31,17 +21,73 @@ size_t MemoryManager::getSecondaryMemoryCapacity() const {
 #include <thread>
 #include <fstream>
 #include <cstdio>
+#include <limits>
 
 // Definição da variável thread_local
 thread_local Cache* MemoryManager::current_thread_cache = nullptr;
+thread_local Cache* MemoryManager::current_thread_icache = nullptr;
+thread_local FetchBuffer* MemoryManager::current_thread_fetch_buffer = nullptr;
+thread_local TLB* MemoryManager::current_thread_tlb = nullptr;
+thread_local const uint64_t* MemoryManager::current_thread_clock = nullptr;
+thread_local TraceBuffer* MemoryManager::current_thread_trace = nullptr;
+thread_local LoadStoreUnit* MemoryManager::current_thread_lsu = nullptr;
+thread_local int MemoryManager::current_thread_node = -1;
+thread_local int MemoryManager::current_thread_core = -1;
+
+// Registro dos shards de estatísticas
+std::mutex MemoryManager::stats_mutex;
+std::vector<std::unique_ptr<MemoryStatShard>> MemoryManager::stat_shards;
 
-// Definição das estatísticas globais
-MemoryStats MemoryManager::global_stats;
+namespace {
+// Shard da thread atual; devolvido ao registro (com as contagens) quando a thread termina
+struct StatShardLease {
+    MemoryStatShard* shard = nullptr;
+    ~StatShardLease() {
+        if (shard) shard->in_use.store(false);
+    }
+};
+thread_local StatShardLease stat_shard_lease;
+}
 
-MemoryManager::MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize) {
-    mainMemory = std::make_unique<MAIN_MEMORY>(mainMemorySize);
-    secondaryMemory = std::make_unique<SECONDARY_MEMORY>(secondaryMemorySize);
+MemoryManager::MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize,
+                             SparseBacking ramBacking, const std::string& diskFile) {
+    mainMemory = std::make_unique<MAIN_MEMORY>(mainMemorySize, ramBacking);
+    secondaryMemory = std::make_unique<SECONDARY_MEMORY>(secondaryMemorySize, diskFile);
     mainMemoryLimit = mainMemorySize;
+    nodeSlice = mainMemorySize;
+    lock_domains.push_back(std::make_unique<StripedLock>());
+}
+
+MemoryStatShard& MemoryManager::localStats() {
+    MemoryStatShard* shard = stat_shard_lease.shard;
+    if (shard) return *shard;
+
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    for (auto& candidate : stat_shards) {
+        if (!candidate->in_use.load()) {
+            shard = candidate.get();
+            break;
+        }
+    }
+    if (!shard) {
+        stat_shards.push_back(std::make_unique<MemoryStatShard>());
+        shard = stat_shards.back().get();
+    }
+    shard->in_use.store(true);
+    stat_shard_lease.shard = shard;
+    return *shard;
+}
+
+MemoryStats MemoryManager::getStats() {
+    MemoryStats total;
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    for (const auto& shard : stat_shards) shard->addTo(total);
+    return total;
+}
+
+void MemoryManager::resetStats() {
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    for (auto& shard : stat_shards) shard->reset();
 }
 
 void MemoryManager::setThreadCache(Cache* l1_cache) {
@@ -52,104 +98,1121 @@ Cache* MemoryManager::getThreadCache() {
     return current_thread_cache;
 }
 
+void MemoryManager::setThreadICache(Cache* l1i_cache, FetchBuffer* fetch_buffer) {
+    current_thread_icache = l1i_cache;
+    current_thread_fetch_buffer = fetch_buffer;
+}
+
+void MemoryManager::setThreadTLB(TLB* tlb) {
+    current_thread_tlb = tlb;
+}
+
+void MemoryManager::setThreadLsu(LoadStoreUnit* lsu) {
+    current_thread_lsu = lsu;
+}
+
+void MemoryManager::setThreadClock(const uint64_t* clock) {
+    current_thread_clock = clock;
+}
+
+void MemoryManager::setThreadTrace(TraceBuffer* buffer) {
+    current_thread_trace = buffer;
+}
+
+void MemoryManager::attachReuseProfiler(PCB& process) const {
+    if (reuseSamplePeriod == 0) return;
+    process.reuse_profile = std::make_unique<ReuseProfiler>(reuseSamplePeriod, l1Config.line_size);
+}
+
+void MemoryManager::setThreadNode(int node) {
+    current_thread_node = node;
+}
+
+void MemoryManager::setThreadCore(int core) {
+    current_thread_core = core;
+}
+
+void MemoryManager::enableNuma(const NumaConfig& config, int numCores) {
+    const size_t ramPages = mainMemoryLimit / VM_PAGE_SIZE;
+    if (config.nodes < 1 || config.nodes > std::max<size_t>(ramPages, 1)) {
+        throw std::invalid_argument("MemoryManager - número de nós NUMA deve estar entre 1 e o número de páginas da RAM");
+    }
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    numaConfig = config;
+    numaNodes = config.nodes;
+    numaCores = std::max(numCores, 1);
+    // Fatias múltiplas da página: uma página (e um quadro) nunca fica entre dois nós
+    const size_t pagesPerNode = (mainMemoryLimit / VM_PAGE_SIZE + numaNodes - 1) / numaNodes;
+    nodeSlice = numaNodes > 1 ? pagesPerNode * VM_PAGE_SIZE : mainMemoryLimit;
+
+    // Um domínio de travas por nó, mais um para o disco
+    lock_domains.clear();
+    const size_t domains = numaNodes > 1 ? numaNodes + 1 : 1;
+    for (size_t i = 0; i < domains; ++i) lock_domains.push_back(std::make_unique<StripedLock>());
+
+    if (vmEnabled) initFrameLists();
+}
+
+int MemoryManager::nodeOfAddress(uint32_t address) const {
+    if (address >= mainMemoryLimit) return -1;
+    return numaNodes > 1 ? static_cast<int>(address / nodeSlice) : 0;
+}
+
+int MemoryManager::nodeOfCore(int coreId) const {
+    if (numaNodes <= 1 || coreId < 0) return 0;
+    if (static_cast<size_t>(coreId) < numaConfig.core_nodes.size()) {
+        const int node = numaConfig.core_nodes[coreId];
+        if (node >= 0 && static_cast<size_t>(node) < numaNodes) return node;
+    }
+    // Padrão: núcleos divididos em blocos contíguos entre os nós
+    return static_cast<int>(static_cast<size_t>(coreId) * numaNodes / std::max(numaCores, coreId + 1));
+}
+
+int MemoryManager::homeNode(const PCB& process) {
+    std::vector<size_t> pages(numaNodes, 0);
+    if (process.address_space) {
+        std::lock_guard<std::mutex> lock(vm_mutex);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            if (frames[i].used && mapsFrame(i, *process.address_space)) ++pages[nodeOfFrame(i)];
+        }
+    } else {
+        const size_t end = size_t(process.program_start_addr) + process.program_size;
+        for (size_t page = process.program_start_addr / VM_PAGE_SIZE; page * VM_PAGE_SIZE < end; ++page) {
+            const int node = nodeOfAddress(static_cast<uint32_t>(page * VM_PAGE_SIZE));
+            if (node >= 0) ++pages[node];
+        }
+    }
+    const auto best = std::max_element(pages.begin(), pages.end());
+    return *best > 0 ? static_cast<int>(best - pages.begin()) : -1;
+}
+
+void MemoryManager::attachAddressSpace(PCB& process) {
+    const uint16_t asid = assignAsid(process);
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    process.address_space = std::make_unique<AddressSpace>(asid);
+}
+
+uint16_t MemoryManager::assignAsid(PCB& process) {
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    if (process.asid == 0) process.asid = nextAsid++;
+    return process.asid;
+}
+
+void MemoryManager::enableVirtualMemory(const TLBConfig& config, PageReplacementPolicy policy, uint64_t wsWindow) {
+    const size_t ramFrames = mainMemoryLimit / VM_PAGE_SIZE;
+    if (ramFrames == 0) {
+        throw std::invalid_argument("MemoryManager - RAM menor que uma página, sem quadros para a memória virtual");
+    }
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    vmEnabled = true;
+    tlbConfig = config;
+    replacementPolicy = policy;
+    replacer = PageReplacer::create(policy, wsWindow);
+    frames.assign(ramFrames, FrameInfo{});
+    initFrameLists();
+}
+
+// Listas de quadros livres por nó (chamar com vm_mutex)
+void MemoryManager::initFrameLists() {
+    freeFrames.assign(numaNodes, {});
+    nextFrame.assign(numaNodes, 0);
+    for (size_t node = 0; node < numaNodes; ++node) {
+        nextFrame[node] = std::min(frames.size(), nodeBase(node) / VM_PAGE_SIZE);
+    }
+}
+
+uint64_t MemoryManager::pageTransferCost(uint32_t slot, const PCB& process) const {
+    return process.memWeights.secondary + diskAccessCost(swapSlotAddress(slot), VM_PAGE_SIZE);
+}
+
+MemoryManager::RangeLock::RangeLock(MemoryManager& manager, uint32_t address, size_t words, bool exclusive)
+    : manager(manager), exclusive(exclusive) {
+    add(address, words);
+    acquire();
+}
+
+MemoryManager::RangeLock::RangeLock(MemoryManager& manager, uint32_t first, uint32_t second,
+                                    size_t words, bool exclusive)
+    : manager(manager), exclusive(exclusive) {
+    add(first, words);
+    add(second, words);
+    acquire();
+}
+
+MemoryManager::RangeLock::~RangeLock() {
+    for (size_t i = count; i-- > 0;) {
+        manager.lock_domains[held[i].domain]->unlock(held[i].mask, exclusive);
+    }
+}
+
+// Acumula as travas da faixa por domínio, mantendo os domínios em ordem crescente
+void MemoryManager::RangeLock::add(uint32_t address, size_t words) {
+    const size_t last = size_t(address) + std::max<size_t>(words, 1) - 1;
+    size_t current = address;
+    while (current <= last) {
+        const size_t domain = manager.lockDomainOf(current);
+        const size_t end = std::min(last, manager.lockDomainEnd(domain));
+        const uint64_t mask = StripedLock::maskFor(manager.lockPageOf(static_cast<uint32_t>(current)),
+                                                   manager.lockPageOf(static_cast<uint32_t>(end)));
+        size_t i = 0;
+        while (i < count && held[i].domain < domain) ++i;
+        if (i < count && held[i].domain == domain) {
+            held[i].mask |= mask;
+        } else {
+            if (count == MAX_DOMAINS) {
+                throw std::length_error("MemoryManager - faixa de memória cobre domínios de travas demais");
+            }
+            for (size_t j = count; j > i; --j) held[j] = held[j - 1];
+            held[i] = Held{domain, mask};
+            ++count;
+        }
+        current = end + 1;
+    }
+}
+
+void MemoryManager::RangeLock::acquire() {
+    for (size_t i = 0; i < count; ++i) {
+        const LockWait wait = manager.lock_domains[held[i].domain]->lock(held[i].mask, exclusive);
+        if (wait.contentions > 0) {
+            localStats().lock_contentions.fetch_add(wait.contentions);
+            localStats().total_lock_wait_ns.fetch_add(wait.wait_ns);
+        }
+    }
+}
+
+size_t MemoryManager::lockDomainOf(size_t address) const {
+    if (lock_domains.size() == 1) return 0;
+    return address < mainMemoryLimit ? address / nodeSlice : numaNodes;
+}
+
+size_t MemoryManager::lockDomainEnd(size_t domain) const {
+    if (lock_domains.size() == 1 || domain >= numaNodes) return SIZE_MAX;
+    return std::min((domain + 1) * nodeSlice, mainMemoryLimit) - 1;
+}
+
+size_t MemoryManager::lockPageOf(uint32_t address) const {
+    if (address < mainMemoryLimit) return address / SPARSE_PAGE_WORDS;
+    const size_t ramPages = (mainMemoryLimit + SPARSE_PAGE_WORDS - 1) / SPARSE_PAGE_WORDS;
+    return ramPages + (address - mainMemoryLimit) / SPARSE_PAGE_WORDS;
+}
+
+void MemoryManager::copyPage(uint32_t from, uint32_t to) {
+    RangeLock lock(*this, from, to, VM_PAGE_SIZE, true);
+    for (uint32_t i = 0; i < VM_PAGE_SIZE; ++i) {
+        writeWordUnlocked(to + i, readWordUnlocked(from + i));
+    }
+}
+
+void MemoryManager::clearPage(uint32_t base) {
+    RangeLock lock(*this, base, VM_PAGE_SIZE, true);
+    for (uint32_t i = 0; i < VM_PAGE_SIZE; ++i) {
+        writeWordUnlocked(base + i, MEMORY_ACCESS_ERROR);
+    }
+}
+
+uint32_t MemoryManager::allocateSwapSlot() {
+    if ((size_t(nextSwapSlot) + 1) * VM_PAGE_SIZE > secondaryMemory->getSize()) {
+        throw std::runtime_error("MemoryManager - área de swap esgotada");
+    }
+    swapRefs.push_back(1);
+    return nextSwapSlot++;
+}
+
+uint32_t MemoryManager::swapSlotRefs(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    return slot < swapRefs.size() ? swapRefs[slot] : 0;
+}
+
+bool MemoryManager::hasSharedFrame(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    return sharedSlotFrames.count(slot) > 0;
+}
+
+// Tira a página do quadro; ela só é gravada no swap se estiver suja (chamar com vm_mutex)
+uint64_t MemoryManager::evictFrame(size_t index, PCB& process) {
+    FrameInfo& frame = frames[index];
+    PageTableEntry& pte = *frame.pte;
+    const uint32_t base = static_cast<uint32_t>(index * VM_PAGE_SIZE);
+
+    // Linhas sujas do quadro na L1 deste núcleo voltam para a RAM antes da cópia
+    invalidateThreadCaches(base, VM_PAGE_SIZE);
+
+    uint64_t cost = 0;
+    if (pte.dirty || pte.swap_slot == NO_SWAP_SLOT) {
+        if (pte.swap_slot == NO_SWAP_SLOT) pte.swap_slot = allocateSwapSlot();
+        copyPage(base, swapSlotAddress(pte.swap_slot));
+        localStats().page_outs.fetch_add(1);
+        localStats().disk_accesses.fetch_add(1);
+        cost = pageTransferCost(pte.swap_slot, process);
+    }
+    // Página compartilhada: sai de todos os espaços que a mapeiam (o slot continua com a cópia)
+    frame.owner->unmap(pte);
+    for (const FrameMapping& mapping : frame.sharers) mapping.space->unmap(*mapping.pte);
+    if (pte.cow) {
+        auto shared = sharedSlotFrames.find(pte.swap_slot);
+        if (shared != sharedSlotFrames.end() && shared->second == index) sharedSlotFrames.erase(shared);
+    }
+    frame = FrameInfo{};
+
+    // Outros núcleos podem ter linhas (limpas) deste quadro: descartam no próximo quantum
+    logEvictedPage(static_cast<uint32_t>(index));
+    return cost;
+}
+
+// Página física cujas linhas nas L1 ficaram obsoletas (chamar com vm_mutex)
+void MemoryManager::logEvictedPage(uint32_t page) {
+    if (evictedFrames.size() >= 4096) {
+        evictedFrames.clear();
+        ++evictionEpoch;
+    }
+    evictedFrames.push_back(page);
+}
+
+// Quadro livre, ou a vítima da política (páginas de processos rodando em outros núcleos ficam).
+// Retorna NO_VICTIM se todos os quadros estão presos a processos em execução.
+size_t MemoryManager::obtainFrame(AddressSpace& space, PCB& process, uint64_t& cost) {
+    // First-touch: quadros do nó do núcleo que falhou primeiro, depois os dos outros nós
+    const size_t local = current_thread_node >= 0 ? static_cast<size_t>(current_thread_node) : 0;
+    for (size_t k = 0; k < numaNodes; ++k) {
+        const size_t node = (local + k) % numaNodes;
+        if (!freeFrames[node].empty()) {
+            const size_t index = freeFrames[node].back();
+            freeFrames[node].pop_back();
+            return index;
+        }
+        const size_t end = std::min(frames.size(), nodeBase(node + 1) / VM_PAGE_SIZE);
+        if (nextFrame[node] < end) return nextFrame[node]++;
+    }
+
+    auto evictable = [&](size_t i) {
+        if (!frames[i].used || (frames[i].owner != &space && frames[i].owner->isRunning())) return false;
+        for (const FrameMapping& mapping : frames[i].sharers) {
+            if (mapping.space != &space && mapping.space->isRunning()) return false;
+        }
+        return true;
+    };
+    // Bits R dos outros mapeamentos de um quadro compartilhado contam na PTE do dono
+    for (FrameInfo& frame : frames) {
+        for (const FrameMapping& mapping : frame.sharers) {
+            if (mapping.pte->referenced.exchange(false)) frame.pte->referenced = true;
+        }
+    }
+    const size_t victim = replacer->selectVictim(frames, evictable);
+    if (victim == NO_VICTIM) return NO_VICTIM;
+    cost += evictFrame(victim, process);
+    return victim;
+}
+
+// Falta de página: traz a página do swap (ou cria uma vazia) para um quadro da RAM.
+// Nulo se nenhum quadro pôde ser obtido agora.
+PageTableEntry* MemoryManager::handlePageFault(AddressSpace& space, uint32_t vpn, PCB& process, uint64_t& cost) {
+    PageTableEntry* existing = space.find(vpn);
+    const uint32_t slot = existing ? existing->swap_slot : NO_SWAP_SLOT;
+    const bool cow = existing && existing->cow;
+
+    // Página COW já trazida por outro processo: basta mapear o mesmo quadro
+    if (cow) {
+        auto shared = sharedSlotFrames.find(slot);
+        if (shared != sharedSlotFrames.end()) {
+            PageTableEntry& pte = space.map(vpn, shared->second);
+            frames[shared->second].sharers.push_back(FrameMapping{&space, &pte});
+            cost += process.memWeights.primary;
+            return &pte;
+        }
+    }
+
+    const size_t index = obtainFrame(space, process, cost);
+    if (index == NO_VICTIM) return nullptr;
+    const uint32_t base = static_cast<uint32_t>(index * VM_PAGE_SIZE);
+
+    // A L1 deste núcleo pode ter linhas antigas do quadro (de outro dono)
+    invalidateThreadCaches(base, VM_PAGE_SIZE);
+
+    if (slot != NO_SWAP_SLOT) {
+        copyPage(swapSlotAddress(slot), base);
+        localStats().disk_accesses.fetch_add(1);
+        cost += pageTransferCost(slot, process);
+    } else {
+        clearPage(base);
+        cost += process.memWeights.primary;
+    }
+
+    PageTableEntry& pte = space.map(vpn, static_cast<uint32_t>(index));
+    claimFrame(index, space, vpn, pte);
+    if (cow) sharedSlotFrames[slot] = static_cast<uint32_t>(index);
+    return &pte;
+}
+
+// Quadro recém-obtido passa a ser de `space` (chamar com vm_mutex)
+void MemoryManager::claimFrame(size_t index, AddressSpace& space, uint32_t vpn, PageTableEntry& pte) {
+    FrameInfo& frame = frames[index];
+    frame.used = true;
+    frame.owner = &space;
+    frame.vpn = vpn;
+    frame.pte = &pte;
+    frame.loaded_at = ++frameTick;
+    frame.last_use = space.virtualTime();
+    frame.age = 0;
+}
+
+bool MemoryManager::mapsFrame(size_t index, const AddressSpace& space) const {
+    const FrameInfo& frame = frames[index];
+    if (frame.owner == &space) return true;
+    for (const FrameMapping& mapping : frame.sharers) {
+        if (mapping.space == &space) return true;
+    }
+    return false;
+}
+
+// Desfaz o mapeamento de `space` em um quadro compartilhado; os outros continuam com ele
+// (chamar com vm_mutex)
+void MemoryManager::detachMapping(size_t index, const AddressSpace& space) {
+    FrameInfo& frame = frames[index];
+    if (frame.owner == &space) {
+        frame.owner->unmap(*frame.pte);
+        frame.owner = frame.sharers.back().space;
+        frame.pte = frame.sharers.back().pte;
+        frame.sharers.pop_back();
+        return;
+    }
+    for (size_t i = 0; i < frame.sharers.size(); ++i) {
+        if (frame.sharers[i].space != &space) continue;
+        frame.sharers[i].space->unmap(*frame.sharers[i].pte);
+        frame.sharers.erase(frame.sharers.begin() + i);
+        return;
+    }
+}
+
+// Primeira escrita em página COW. Se ninguém mais usa a cópia (slot só deste processo,
+// ou quadro sem outros mapeamentos) a página vira privada sem copiar; senão ganha um
+// quadro novo com a cópia. Nulo se nenhum quadro pôde ser obtido agora (chamar com vm_mutex).
+PageTableEntry* MemoryManager::breakCow(AddressSpace& space, uint32_t vpn, PageTableEntry& pte,
+                                        PCB& process, uint64_t& cost) {
+    const uint32_t slot = pte.swap_slot;
+    if (swapRefs[slot] == 1 || (pte.present && frames[pte.frame].sharers.empty())) {
+        if (pte.present) {
+            auto shared = sharedSlotFrames.find(slot);
+            if (shared != sharedSlotFrames.end() && shared->second == pte.frame) sharedSlotFrames.erase(shared);
+        }
+        if (swapRefs[slot] > 1) {
+            // O slot continua com os outros processos; a página é regravada no despejo
+            --swapRefs[slot];
+            pte.swap_slot = NO_SWAP_SLOT;
+        }
+        pte.cow = false;
+        return pte.present ? &pte : handlePageFault(space, vpn, process, cost);
+    }
+
+    const size_t index = obtainFrame(space, process, cost);
+    if (index == NO_VICTIM) return nullptr;
+    const uint32_t base = static_cast<uint32_t>(index * VM_PAGE_SIZE);
+    invalidateThreadCaches(base, VM_PAGE_SIZE);
+
+    // Origem: o quadro compartilhado (se obtainFrame não o despejou) ou o slot de swap
+    auto shared = sharedSlotFrames.find(slot);
+    if (shared != sharedSlotFrames.end()) {
+        copyPage(shared->second * VM_PAGE_SIZE, base);
+        cost += process.memWeights.primary;
+    } else {
+        copyPage(swapSlotAddress(slot), base);
+        localStats().disk_accesses.fetch_add(1);
+        cost += pageTransferCost(slot, process);
+    }
+    if (pte.present) detachMapping(pte.frame, space);
+    --swapRefs[slot];
+    pte.swap_slot = NO_SWAP_SLOT;
+    pte.cow = false;
+
+    space.map(vpn, static_cast<uint32_t>(index));
+    claimFrame(index, space, vpn, pte);
+    localStats().cow_copies.fetch_add(1);
+    process.cow_copies.fetch_add(1);
+    return &pte;
+}
+
+void MemoryManager::swapOut(PCB& process) {
+    if (!process.address_space) return;
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (!frames[i].used || !mapsFrame(i, *process.address_space)) continue;
+        if (!frames[i].sharers.empty()) {
+            // Quadro compartilhado fica com os outros processos
+            detachMapping(i, *process.address_space);
+            continue;
+        }
+        evictFrame(i, process);
+        freeFrames[nodeOfFrame(i)].push_back(static_cast<uint32_t>(i));
+    }
+    frame_released.notify_all();
+}
+
+bool MemoryManager::shareImage(const PCB& source, PCB& target) {
+    if (!source.address_space || !target.address_space || source.program_size == 0) return false;
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    const uint32_t first = source.program_start_addr / VM_PAGE_SIZE;
+    const uint32_t last = (source.program_start_addr + source.program_size - 1) / VM_PAGE_SIZE;
+    for (uint32_t vpn = first; vpn <= last; ++vpn) {
+        const PageTableEntry* from = source.address_space->find(vpn);
+        if (!from || from->present || from->swap_slot == NO_SWAP_SLOT) return false;
+    }
+    // Texto e dados ficam nos mesmos slots: o texto nunca é escrito e continua
+    // compartilhado; cada página de dados ganha uma cópia só na primeira escrita
+    for (uint32_t vpn = first; vpn <= last; ++vpn) {
+        PageTableEntry& from = *source.address_space->find(vpn);
+        PageTableEntry& to = target.address_space->entry(vpn);
+        to.swap_slot = from.swap_slot;
+        to.cow = true;
+        from.cow = true;
+        ++swapRefs[from.swap_slot];
+    }
+    target.program_start_addr = source.program_start_addr;
+    target.program_size = source.program_size;
+    return true;
+}
+
+void MemoryManager::beginQuantum(PCB& process, Cache* l1_cache, EvictionCursor& cursor, Cache* l1i_cache) {
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    if (process.address_space) process.address_space->setRunning(true);
+
+    // A L1 está limpa aqui (write-back no fim do quantum anterior) e a L1I nunca
+    // fica suja: basta descartar
+    for (Cache* cache : {l1_cache, l1i_cache}) {
+        if (!cache) continue;
+        if (cursor.epoch != evictionEpoch) {
+            cache->invalidate();
+            continue;
+        }
+        for (size_t i = cursor.index; i < evictedFrames.size(); ++i) {
+            cache->invalidateRange(size_t(evictedFrames[i]) * VM_PAGE_SIZE, VM_PAGE_SIZE, nullptr);
+        }
+    }
+    cursor.epoch = evictionEpoch;
+    cursor.index = evictedFrames.size();
+}
+
+void MemoryManager::invalidateThreadCaches(uint32_t base, size_t size) {
+    if (current_thread_cache) current_thread_cache->invalidateRange(base, size, this);
+    if (current_thread_icache) current_thread_icache->invalidateRange(base, size, nullptr);
+    if (current_thread_fetch_buffer) current_thread_fetch_buffer->invalidateRange(base, size);
+    if (l2) l2->invalidateRange(base, size);
+}
+
+void MemoryManager::reserveCacheClass(int clos) {
+    if (clos < 0) return;
+    std::lock_guard<std::mutex> lock(class_mutex);
+    reservedClasses[std::min(clos, L2_MAX_CLASSES - 1)] = true;
+}
+
+void MemoryManager::assignCacheClass(PCB& process) {
+    if (!l2) return;
+    std::lock_guard<std::mutex> lock(class_mutex);
+    if (process.cache_class < 0 && process.cache_mask != 0) {
+        // Classe própria: a mais alta livre, pulando as pedidas explicitamente (a 0 é de todos)
+        while (nextPrivateClass > 0 && reservedClasses[nextPrivateClass]) --nextPrivateClass;
+        if (nextPrivateClass == 0) {
+            std::cerr << "Aviso: classes de serviço da L2 esgotadas; P" << process.pid
+                      << " fica na classe 0 e a máscara 0x" << std::hex << process.cache_mask << std::dec
+                      << " não é aplicada\n";
+            return;
+        }
+        process.cache_class = nextPrivateClass--;
+    }
+    if (process.cache_class >= L2_MAX_CLASSES) process.cache_class = L2_MAX_CLASSES - 1;
+    if (process.cache_class >= 0 && process.cache_mask != 0) l2->setMask(process.cache_class, process.cache_mask);
+}
+
+// Buddy por nó NUMA da RAM + um para o disco, criados no primeiro uso (depois de enableNuma)
+void MemoryManager::initSegments() {
+    if (!ramSegments.empty()) return;
+    for (size_t node = 0; node < numaNodes; ++node) {
+        const size_t begin = std::min(nodeBase(node), mainMemoryLimit);
+        const size_t end = std::min(nodeBase(node + 1), mainMemoryLimit);
+        ramSegments.push_back(std::make_unique<BuddyAllocator>(begin, end - begin));
+    }
+    diskSegments = std::make_unique<BuddyAllocator>(mainMemoryLimit, secondaryMemory->getSize());
+}
+
+uint32_t MemoryManager::allocateSegment(size_t words, int preferredNode, bool allowDisk) {
+    std::lock_guard<std::mutex> lock(segment_mutex);
+    initSegments();
+    const size_t first = preferredNode >= 0 ? static_cast<size_t>(preferredNode) % numaNodes : 0;
+    for (size_t k = 0; k < numaNodes; ++k) {
+        const size_t address = ramSegments[(first + k) % numaNodes]->allocate(words);
+        if (address != NO_SEGMENT) return static_cast<uint32_t>(address);
+    }
+    if (allowDisk) {
+        const size_t address = diskSegments->allocate(words);
+        if (address != NO_SEGMENT) return static_cast<uint32_t>(address);
+    }
+    return SEGMENT_UNAVAILABLE;
+}
+
+void MemoryManager::releaseProcessMemory(PCB& process) {
+    if (process.address_space || process.segment_limit == 0) return;
+    const uint32_t base = process.segment_base_addr;
+    {
+        // Limpa a imagem antes de devolver o bloco: a ocupação volta a refletir só os vivos
+        RangeLock range(*this, base, process.segment_limit, true);
+        for (uint32_t i = 0; i < process.segment_limit; ++i) {
+            writeWordUnlocked(base + i, MEMORY_ACCESS_ERROR);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(segment_mutex);
+        bool released = false;
+        for (auto& segments : ramSegments) released = released || segments->release(base);
+        if (!released && diskSegments) released = diskSegments->release(base);
+        if (!released) return;  // Segmento não veio de allocateSegment
+    }
+    // O segmento pode ser reaproveitado: as L1 descartam as linhas dele no próximo quantum
+    std::lock_guard<std::mutex> lock(vm_mutex);
+    const size_t end = size_t(base) + process.segment_limit;
+    for (size_t page = base / VM_PAGE_SIZE; page * VM_PAGE_SIZE < end; ++page) {
+        logEvictedPage(static_cast<uint32_t>(page));
+    }
+    process.segment_limit = 0;
+}
+
+FragmentationReport MemoryManager::getFragmentation(bool disk) const {
+    std::lock_guard<std::mutex> lock(segment_mutex);
+    FragmentationReport report;
+    if (disk) {
+        if (diskSegments) report = diskSegments->report();
+    } else {
+        for (const auto& segments : ramSegments) report.merge(segments->report());
+    }
+    return report;
+}
+
+void MemoryManager::endQuantum(PCB& process) {
+    if (!process.address_space) return;
+    {
+        std::lock_guard<std::mutex> lock(vm_mutex);
+        process.address_space->setRunning(false);
+    }
+    // Os quadros do processo voltam a ser vítimas possíveis
+    frame_released.notify_all();
+}
+
+// Tradução virtual -> física. Na TLB miss a tabela de páginas é percorrida e o custo
+// (um acesso à RAM por nível) é cobrado do processo; páginas fora da RAM geram uma
+// falta de página. Leituras de páginas nunca escritas falham sem alocar quadro.
+bool MemoryManager::translate(uint32_t vaddr, PCB& process, bool is_write, uint32_t& paddr) {
+    AddressSpace& space = *process.address_space;
+    const uint32_t vpn = AddressSpace::pageOf(vaddr);
+    TLB* tlb = current_thread_tlb;
+    space.tick();
+
+    PageTableEntry* pte = tlb ? tlb->lookup(space.getAsid(), vpn) : nullptr;
+    const bool tlb_hit = pte != nullptr;
+    if (tlb_hit) {
+        localStats().tlb_hits.fetch_add(1);
+        process.tlb_hits.fetch_add(1);
+    }
+    // Escrita em página compartilhada (COW) também passa pelo caminho lento
+    if (!pte || (is_write && pte->cow)) {
+        uint64_t fault_cost = 0;
+        bool faulted = false;
+        {
+            std::unique_lock<std::mutex> lock(vm_mutex);
+            while (true) {
+                pte = space.find(vpn);
+                if (pte && is_write && pte->cow) {
+                    pte = breakCow(space, vpn, *pte, process, fault_cost);
+                    faulted = true;
+                    if (pte) break;
+                } else {
+                    const bool in_swap = pte && pte->swap_slot != NO_SWAP_SLOT;
+                    if ((pte && pte->present) || !(is_write || in_swap)) break;
+                    pte = handlePageFault(space, vpn, process, fault_cost);
+                    faulted = true;
+                    if (pte) break;
+                }
+                // Todos os quadros estão com processos em execução: dorme até algum
+                // quantum terminar ou algum processo devolver quadros
+                frame_released.wait(lock);
+            }
+        }
+        // Carga do programa (sem TLB, fora dos núcleos) não paga page walk nem faltas
+        if (tlb) {
+            if (!tlb_hit) {
+                const uint64_t walk = AddressSpace::LEVELS * process.memWeights.primary;
+                localStats().tlb_misses.fetch_add(1);
+                process.tlb_misses.fetch_add(1);
+                process.page_walk_cycles.fetch_add(walk);
+                process.memory_cycles.fetch_add(walk);
+            }
+            if (faulted) {
+                localStats().page_faults.fetch_add(1);
+                process.page_faults.fetch_add(1);
+                process.fault_service_cycles.fetch_add(fault_cost);
+                process.memory_cycles.fetch_add(fault_cost);
+            }
+        }
+        if (!pte || !pte->present) return false;
+        if (tlb && !tlb_hit) tlb->insert(space.getAsid(), vpn, pte);
+    }
+
+    pte->referenced = true;
+    if (is_write) pte->dirty = true;
+    paddr = pte->frame * VM_PAGE_SIZE + AddressSpace::offsetOf(vaddr);
+    return true;
+}
+
+uint32_t MemoryManager::readWordUnlocked(uint32_t address) const {
+    if (address < mainMemoryLimit) {
+        return mainMemory->ReadMem(address);
+    }
+    return secondaryMemory->ReadMem(address - mainMemoryLimit);
+}
+
+void MemoryManager::writeWordUnlocked(uint32_t address, uint32_t data) {
+    if (address < mainMemoryLimit) {
+        mainMemory->WriteMem(address, data);
+    } else {
+        secondaryMemory->WriteMem(address - mainMemoryLimit, data);
+    }
+}
+
+void MemoryManager::readLineUnlocked(uint32_t base, size_t line_size, std::vector<uint32_t>& out) const {
+    out.resize(line_size);
+    for (size_t i = 0; i < line_size; ++i) {
+        out[i] = readWordUnlocked(base + static_cast<uint32_t>(i));
+    }
+}
+
+// Custo extra de um acesso ao disco: fixo + páginas do disco cobertas por [address, address + words)
+uint64_t MemoryManager::diskAccessCost(uint32_t address, size_t words) const {
+    const size_t first = (address - mainMemoryLimit) / SPARSE_PAGE_WORDS;
+    const size_t last = (address - mainMemoryLimit + std::max<size_t>(words, 1) - 1) / SPARSE_PAGE_WORDS;
+    return diskLatency.fixed + diskLatency.per_page * (last - first + 1);
+}
+
+// Pedido à DRAM no relógio do núcleo atual; retorna serviço + espera na fila.
+// Write-backs e prefetches (sem processo) também ocupam os bancos, mas não são cobrados.
+uint64_t MemoryManager::dramAccess(uint32_t address, PCB* process) {
+    const uint64_t now = current_thread_clock ? *current_thread_clock : dram->clock();
+    const DramAccess access = dram->access(address, now);
+
+    MemoryStatShard& stats = localStats();
+    switch (access.outcome) {
+        case RowOutcome::Hit:      stats.dram_row_hits.fetch_add(1); break;
+        case RowOutcome::Conflict: stats.dram_row_conflicts.fetch_add(1); break;
+        default:                   stats.dram_row_misses.fetch_add(1); break;
+    }
+    stats.dram_queue_cycles.fetch_add(access.queue_delay);
+    if (process) {
+        switch (access.outcome) {
+            case RowOutcome::Hit:      process->dram_row_hits.fetch_add(1); break;
+            case RowOutcome::Conflict: process->dram_row_conflicts.fetch_add(1); break;
+            default:                   process->dram_row_misses.fetch_add(1); break;
+        }
+        process->dram_queue_cycles.fetch_add(access.queue_delay);
+    }
+    return access.latency + access.queue_delay;
+}
+
+// Transferência de `words` palavras pelo barramento no relógio do núcleo atual; retorna
+// ocupação + espera pelo árbitro. Write-backs e prefetches disputam com a menor prioridade.
+uint64_t MemoryManager::busAccess(size_t words, PCB* process) {
+    const uint64_t now = current_thread_clock ? *current_thread_clock : bus->clock();
+    const int priority = process ? process->priority : std::numeric_limits<int>::min();
+    const BusGrant grant = bus->request(current_thread_core, priority, words, now);
+
+    MemoryStatShard& stats = localStats();
+    stats.bus_transfers.fetch_add(1);
+    stats.bus_queue_cycles.fetch_add(grant.queue_delay);
+    if (process) {
+        process->bus_transfers.fetch_add(1);
+        process->bus_queue_cycles.fetch_add(grant.queue_delay);
+    }
+    return grant.transfer + grant.queue_delay;
+}
+
+// Controlador de memória do endereço: o do nó NUMA, ou páginas intercaladas entre eles
+size_t MemoryManager::controllerOf(uint32_t address) const {
+    const size_t controllers = noc->getConfig().memory_controllers;
+    if (address >= mainMemoryLimit) return 0;
+    if (numaNodes > 1) return static_cast<size_t>(nodeOfAddress(address)) % controllers;
+    return (address / VM_PAGE_SIZE) % controllers;
+}
+
+uint64_t MemoryManager::nocSend(size_t src, size_t dst, size_t words, uint64_t now, PCB* process) {
+    const NocTransfer transfer = noc->send(src, dst, words, now);
+    if (transfer.hops == 0) return 0;
+
+    MemoryStatShard& stats = localStats();
+    stats.noc_messages.fetch_add(1);
+    stats.noc_hops.fetch_add(transfer.hops);
+    stats.noc_wait_cycles.fetch_add(transfer.wait);
+    if (process) {
+        process->noc_cycles.fetch_add(transfer.cycles);
+        process->noc_wait_cycles.fetch_add(transfer.wait);
+    }
+    return transfer.cycles;
+}
+
+// Mensagens de um miss da L1: pedido (1 palavra) e resposta com a linha, do núcleo ao
+// banco da L2 e, se ela falhar, do banco ao controlador de memória. Sem processo
+// (prefetch) a rede fica ocupada, mas ninguém é cobrado.
+uint64_t MemoryManager::missTraffic(uint32_t base, size_t words, bool via_l2, bool l2_hit, PCB* process) {
+    if (!noc || current_thread_core < 0) return 0;
+    const uint64_t now = current_thread_clock ? *current_thread_clock : noc->clock();
+    const size_t core = noc->tileOfCore(current_thread_core);
+    const size_t controller = noc->controllerTile(controllerOf(base));
+
+    uint64_t cycles = 0;
+    size_t home = core;
+    if (via_l2) {
+        home = noc->bankOf(base, l1Config.line_size);
+        cycles += nocSend(core, home, 1, now, process);
+    }
+    if (!l2_hit) {
+        cycles += nocSend(home, controller, 1, now + cycles, process);
+        cycles += nocSend(controller, home, words, now + cycles, process);
+    }
+    if (home != core) cycles += nocSend(home, core, words, now + cycles, process);
+    return cycles;
+}
+
+// Write-back: a linha vai do núcleo ao controlador de memória (não aloca na L2)
+void MemoryManager::writeBackTraffic(uint32_t base, size_t words) {
+    if (!noc || current_thread_core < 0) return;
+    const uint64_t now = current_thread_clock ? *current_thread_clock : noc->clock();
+    nocSend(noc->tileOfCore(current_thread_core), noc->controllerTile(controllerOf(base)), words, now, nullptr);
+}
+
+// Contabiliza um acesso (palavra ou linha inteira) à RAM/Disco
+void MemoryManager::chargeMemoryAccess(uint32_t address, PCB& process, size_t words) {
+    if (address < mainMemoryLimit) {
+        localStats().ram_accesses.fetch_add(1);
+        process.primary_mem_accesses.fetch_add(1);
+        process.memory_cycles.fetch_add(dram ? dramAccess(address, &process) : process.memWeights.primary);
+        if (bus) process.memory_cycles.fetch_add(busAccess(words, &process));
+        if (numaNodes > 1 && current_thread_node >= 0 && nodeOfAddress(address) != current_thread_node) {
+            // Acesso à fatia da RAM de outro nó NUMA
+            localStats().numa_remote_accesses.fetch_add(1);
+            process.remote_mem_accesses.fetch_add(1);
+            process.memory_cycles.fetch_add(numaConfig.remote_latency);
+        }
+    } else {
+        localStats().disk_accesses.fetch_add(1);
+        process.secondary_mem_accesses.fetch_add(1);
+        process.memory_cycles.fetch_add(process.memWeights.secondary + diskAccessCost(address, words));
+    }
+}
+
+// Miss: traz a linha inteira que contém `address` em um único acesso à memória
+uint32_t MemoryManager::fillLine(Cache* l1_cache, uint32_t address, PCB& process) {
+    const uint32_t base = static_cast<uint32_t>(l1_cache->lineAddress(address));
+    std::vector<uint32_t> line;
+    {
+        RangeLock lock(*this, base, l1_cache->lineSize(), false);
+        const bool l2_hit = l2 && l2->access(base, process.cache_class);
+        if (l2_hit) {
+            localStats().l2_hits.fetch_add(1);
+            process.l2_hits.fetch_add(1);
+            process.memory_cycles.fetch_add(l2->getConfig().latency);
+        } else {
+            if (l2) {
+                localStats().l2_misses.fetch_add(1);
+                process.l2_misses.fetch_add(1);
+            }
+            chargeMemoryAccess(base, process, l1_cache->lineSize());
+        }
+        if (noc) process.memory_cycles.fetch_add(missTraffic(base, l1_cache->lineSize(), l2 != nullptr, l2_hit, &process));
+        readLineUnlocked(base, l1_cache->lineSize(), line);
+    }
+    l1_cache->put(base, line, this);
+    return line[address - base];
+}
+
+void MemoryManager::issuePrefetches(Cache* l1_cache, uint32_t address, CacheLookup result, PCB& process) {
+    if (!l1_cache->hasPrefetcher()) return;
+
+    // O prefetcher dispara em misses e no primeiro uso de linhas pré-buscadas
+    const bool trigger = (result != CacheLookup::Hit);
+    std::vector<size_t> candidates;
+    l1_cache->prefetchCandidates(process.regBank.pc.read(), address, trigger, candidates);
+
+    const size_t capacity = getTotalCapacity();
+    std::vector<uint32_t> line;
+    for (size_t candidate : candidates) {
+        if (candidate >= capacity || l1_cache->contains(candidate)) continue;
+        // Com memória virtual, páginas vizinhas no espaço físico pertencem a outros mapeamentos
+        if (process.address_space && candidate / VM_PAGE_SIZE != address / VM_PAGE_SIZE) continue;
+        const uint32_t base = static_cast<uint32_t>(candidate);
+        {
+            RangeLock lock(*this, base, l1_cache->lineSize(), false);
+            // Como no miss de demanda, a linha passa pela L2: entra nas tags e na partição
+            // da classe do processo (sem cobrar o processo)
+            const bool l2_hit = l2 && l2->access(base, process.cache_class);
+            if (l2) {
+                if (l2_hit) localStats().l2_hits.fetch_add(1);
+                else localStats().l2_misses.fetch_add(1);
+            }
+            if (!l2_hit) {
+                if (base < mainMemoryLimit) {
+                    localStats().ram_accesses.fetch_add(1);
+                    if (dram) dramAccess(base, nullptr);
+                    if (bus) busAccess(l1_cache->lineSize(), nullptr);
+                } else {
+                    localStats().disk_accesses.fetch_add(1);
+                }
+            }
+            if (noc && (l2_hit || base < mainMemoryLimit)) {
+                missTraffic(base, l1_cache->lineSize(), l2 != nullptr, l2_hit, nullptr);
+            }
+            readLineUnlocked(base, l1_cache->lineSize(), line);
+        }
+        l1_cache->put(base, line, this, true);
+        localStats().prefetch_issued.fetch_add(1);
+        process.prefetch_issued.fetch_add(1);
+    }
+}
+
 uint32_t MemoryManager::read(uint32_t address, PCB& process) {
+    if (!current_thread_lsu) return readAccess(address, process);
+    return timedLoad(address, process, -1);
+}
+
+uint32_t MemoryManager::load(uint32_t address, PCB& process, int dest_register) {
+    if (!current_thread_lsu) return readAccess(address, process);
+    return timedLoad(address, process, dest_register);
+}
+
+uint32_t MemoryManager::fetch(uint32_t address, PCB& process) {
+    if (!current_thread_icache) return read(address, process);
+    // A busca não passa pela LSU: o pipeline sempre espera a instrução
+    const uint64_t before = process.memory_cycles.load();
+    const uint32_t instruction = fetchAccess(address, process);
+    process.fetch_cycles.fetch_add(process.memory_cycles.load() - before);
+    return instruction;
+}
+
+void MemoryManager::write(uint32_t address, uint32_t data, PCB& process) {
+    if (!current_thread_lsu) {
+        writeAccess(address, data, process);
+        return;
+    }
+    const uint64_t before = process.memory_cycles.load();
+    writeAccess(address, data, process);
+    const uint64_t latency = process.memory_cycles.load() - before;
+    const uint64_t now = current_thread_clock ? *current_thread_clock : 0;
+    chargeStall(process, latency, current_thread_lsu->store(address, latency, now));
+}
+
+// A latência medida no acesso síncrono vira a espera que a LSU decidir
+uint32_t MemoryManager::timedLoad(uint32_t address, PCB& process, int dest_register) {
+    const uint64_t before = process.memory_cycles.load();
+    bool miss = false;
+    const uint32_t value = readAccess(address, process, &miss);
+    const uint64_t latency = process.memory_cycles.load() - before;
+    const uint64_t now = current_thread_clock ? *current_thread_clock : 0;
+    chargeStall(process, latency, current_thread_lsu->load(address, latency, miss, now, dest_register));
+    return value;
+}
+
+void MemoryManager::chargeStall(PCB& process, uint64_t latency, uint64_t stall) {
+    if (stall >= latency) process.memory_cycles.fetch_add(stall - latency);
+    else process.memory_cycles.fetch_sub(latency - stall);
+}
+
+uint32_t MemoryManager::readAccess(uint32_t address, PCB& process, bool* l1_miss) {
     process.mem_accesses_total.fetch_add(1);
     process.mem_reads.fetch_add(1);
 
+    if (process.address_space && !translate(address, process, false, address)) {
+        return MEMORY_ACCESS_ERROR; // Página nunca escrita
+    }
+    if (current_thread_trace) current_thread_trace->record(process.regBank.pc.read(), address, process.pid, 0);
+    if (process.reuse_profile) process.reuse_profile->access(address);
+
     // Cache L1 privada (thread_local, SEM LOCKS!)
     Cache* l1_cache = current_thread_cache;
     
     if (l1_cache) {
-        size_t cache_data = l1_cache->get(address);
-        if (cache_data != CACHE_MISS) {
+        uint32_t cache_data;
+        CacheLookup result = l1_cache->lookup(address, cache_data);
+        if (result != CacheLookup::Miss) {
             // Cache HIT - extremamente rápido!
-            global_stats.cache_hits.fetch_add(1);
+            localStats().cache_hits.fetch_add(1);
             process.cache_mem_accesses.fetch_add(1);
             process.memory_cycles.fetch_add(process.memWeights.cache);
             contabiliza_cache(process, true);
+            if (result == CacheLookup::PrefetchHit) {
+                localStats().prefetch_useful.fetch_add(1);
+                process.prefetch_hits.fetch_add(1);
+            }
+            issuePrefetches(l1_cache, address, result, process);
             return cache_data;
         }
         
-        // Cache MISS
-        global_stats.cache_misses.fetch_add(1);
+        // Cache MISS: busca a linha inteira (RAM/Disco compartilhados, trava só as páginas da linha)
+        if (l1_miss) *l1_miss = true;
+        localStats().cache_misses.fetch_add(1);
         contabiliza_cache(process, false);
+        contabiliza_miss(process, l1_cache->lastMissClass());
+        cache_data = fillLine(l1_cache, address, process);
+        issuePrefetches(l1_cache, address, result, process);
+        return cache_data;
     }
 
-    // Lê da RAM/Disco (compartilhado, usa shared_lock)
-    uint32_t data_from_mem;
-    {
-        std::shared_lock<std::shared_mutex> lock(memory_mutex);
-        
-        if (address < mainMemoryLimit) {
-            global_stats.ram_accesses.fetch_add(1);
-            process.primary_mem_accesses.fetch_add(1);
-            process.memory_cycles.fetch_add(process.memWeights.primary);
-            data_from_mem = mainMemory->ReadMem(address);
-        } else {
-            global_stats.disk_accesses.fetch_add(1);
-            process.secondary_mem_accesses.fetch_add(1);
-            process.memory_cycles.fetch_add(process.memWeights.secondary);
-            uint32_t secondaryAddress = address - mainMemoryLimit;
-            data_from_mem = secondaryMemory->ReadMem(secondaryAddress);
-        }
-    }
-
-    // Armazena na cache L1 (sem locks!)
-    if (l1_cache) {
-        l1_cache->put(address, data_from_mem, nullptr);
-    }
-
-    return data_from_mem;
+    // Sem cache: lê a palavra direto da RAM/Disco
+    if (l1_miss) *l1_miss = true;
+    RangeLock lock(*this, address, 1, false);
+    chargeMemoryAccess(address, process);
+    if (noc) process.memory_cycles.fetch_add(missTraffic(address, 1, false, false, &process));
+    return readWordUnlocked(address);
 }
 
-void MemoryManager::write(uint32_t address, uint32_t data, PCB& process) {
+void MemoryManager::writeAccess(uint32_t address, uint32_t data, PCB& process) {
     process.mem_accesses_total.fetch_add(1);
     process.mem_writes.fetch_add(1);
 
+    if (process.address_space && !translate(address, process, true, address)) {
+        return; // Sem tradução: não escreve no endereço virtual como se fosse físico
+    }
+    if (current_thread_trace) current_thread_trace->record(process.regBank.pc.read(), address, process.pid, TRACE_WRITE);
+    if (process.reuse_profile) process.reuse_profile->access(address);
+
     Cache* l1_cache = current_thread_cache;
     
     if (l1_cache) {
-        size_t cache_data = l1_cache->get(address);
+        uint32_t cache_data;
+        CacheLookup result = l1_cache->lookup(address, cache_data);
 
-        if (cache_data == CACHE_MISS) {
+        if (result == CacheLookup::Miss) {
+            // Mesma população do PCB: escritas também contam em hits/misses globais
+            localStats().cache_misses.fetch_add(1);
             contabiliza_cache(process, false);
+            contabiliza_miss(process, l1_cache->lastMissClass());
             
-            // Write-allocate: carrega na cache primeiro
-            uint32_t data_from_mem;
-            {
-                std::shared_lock<std::shared_mutex> lock(memory_mutex);
-                
-                if (address < mainMemoryLimit) {
-                    process.primary_mem_accesses.fetch_add(1);
-                    process.memory_cycles.fetch_add(process.memWeights.primary);
-                    data_from_mem = mainMemory->ReadMem(address);
-                } else {
-                    process.secondary_mem_accesses.fetch_add(1);
-                    process.memory_cycles.fetch_add(process.memWeights.secondary);
-                    uint32_t secondaryAddress = address - mainMemoryLimit;
-                    data_from_mem = secondaryMemory->ReadMem(secondaryAddress);
-                }
-            }
-            
-            l1_cache->put(address, data_from_mem, nullptr);
+            // Write-allocate: carrega a linha na cache primeiro
+            fillLine(l1_cache, address, process);
         } else {
+            localStats().cache_hits.fetch_add(1);
             contabiliza_cache(process, true);
+            if (result == CacheLookup::PrefetchHit) {
+                localStats().prefetch_useful.fetch_add(1);
+                process.prefetch_hits.fetch_add(1);
+            }
         }
 
-        // Atualiza cache (sem locks!)
+        // Atualiza cache (sem locks!) - a linha fica suja até o write-back
         l1_cache->update(address, data);
         process.cache_mem_accesses.fetch_add(1);
         process.memory_cycles.fetch_add(process.memWeights.cache);
+        issuePrefetches(l1_cache, address, result, process);
         
     } else {
         // Sem cache, escreve direto na RAM/Disco
-        std::unique_lock<std::shared_mutex> lock(memory_mutex);
-        
-        if (address < mainMemoryLimit) {
-            mainMemory->WriteMem(address, data);
+        RangeLock lock(*this, address, 1, true);
+        writeWordUnlocked(address, data);
+    }
+
+    // Código automodificável: a cópia da linha no lado de instruções fica velha
+    if (current_thread_icache && current_thread_icache->contains(address)) {
+        current_thread_icache->invalidateRange(current_thread_icache->lineAddress(address), 1, nullptr);
+    }
+    if (current_thread_fetch_buffer) current_thread_fetch_buffer->invalidateRange(address, 1);
+}
+
+uint32_t MemoryManager::fetchAccess(uint32_t address, PCB& process) {
+    process.ifetch_accesses.fetch_add(1);
+
+    if (process.address_space && !translate(address, process, false, address)) {
+        return MEMORY_ACCESS_ERROR;
+    }
+    if (current_thread_trace) current_thread_trace->record(process.regBank.pc.read(), address, process.pid, TRACE_FETCH);
+
+    uint32_t instruction;
+    FetchBuffer* buffer = current_thread_fetch_buffer;
+    if (buffer && buffer->read(address, instruction)) {
+        // Mesma linha da busca anterior: já está no núcleo, sem custo de memória
+        localStats().fetch_buffer_hits.fetch_add(1);
+        process.fetch_buffer_hits.fetch_add(1);
+        return instruction;
+    }
+
+    Cache* l1i_cache = current_thread_icache;
+    if (l1i_cache->lookup(address, instruction) != CacheLookup::Miss) {
+        localStats().ifetch_hits.fetch_add(1);
+        process.ifetch_hits.fetch_add(1);
+        process.memory_cycles.fetch_add(process.memWeights.cache);
+    } else {
+        localStats().ifetch_misses.fetch_add(1);
+        process.ifetch_misses.fetch_add(1);
+        // A L1 de dados pode ter a versão mais nova da linha (suja, ainda sem write-back)
+        const CacheLine* data_line = current_thread_cache ? current_thread_cache->peek(address) : nullptr;
+        if (data_line && data_line->data.size() == l1i_cache->lineSize()) {
+            l1i_cache->put(data_line->tag, data_line->data, this);
+            process.memory_cycles.fetch_add(process.memWeights.cache);
+            instruction = data_line->data[address - data_line->tag];
+        } else {
+            instruction = fillLine(l1i_cache, address, process);
+        }
+    }
+
+    if (buffer) {
+        const CacheLine* line = l1i_cache->peek(address);
+        if (line) buffer->fill(static_cast<uint32_t>(line->tag), line->data);
+    }
+    return instruction;
+}
+
+void MemoryManager::loadImage(uint32_t address, const uint32_t* words, size_t count, PCB& process) {
+    if (count == 0) return;
+    if (!process.address_space) {
+        RangeLock lock(*this, address, (count - 1) * IMAGE_WORD_STRIDE + 1, true);
+        for (size_t i = 0; i < count; ++i) {
+            writeWordUnlocked(address + static_cast<uint32_t>(i * IMAGE_WORD_STRIDE), words[i]);
+        }
+        return;
+    }
+
+    // Memória virtual: cada página da imagem é gravada onde a PTE aponta (normalmente
+    // um slot novo de swap, como se tivesse sido escrita e despejada)
+    AddressSpace& space = *process.address_space;
+    std::lock_guard<std::mutex> vm_lock(vm_mutex);
+    size_t i = 0;
+    while (i < count) {
+        const uint32_t first = address + static_cast<uint32_t>(i * IMAGE_WORD_STRIDE);
+        const uint32_t vpn = AddressSpace::pageOf(first);
+        PageTableEntry& pte = space.entry(vpn);
+        if (pte.cow) throw std::logic_error("MemoryManager::loadImage - página compartilhada (copy-on-write)");
+
+        uint32_t base;
+        if (pte.present) {
+            base = pte.frame * VM_PAGE_SIZE;
+            pte.dirty = true;
         } else {
-            uint32_t secondaryAddress = address - mainMemoryLimit;
-            secondaryMemory->WriteMem(secondaryAddress, data);
+            if (pte.swap_slot == NO_SWAP_SLOT) pte.swap_slot = allocateSwapSlot();
+            base = swapSlotAddress(pte.swap_slot);
+        }
+        size_t end = i + 1;
+        while (end < count && AddressSpace::pageOf(address + static_cast<uint32_t>(end * IMAGE_WORD_STRIDE)) == vpn) ++end;
+
+        RangeLock lock(*this, base + AddressSpace::offsetOf(first), (end - i - 1) * IMAGE_WORD_STRIDE + 1, true);
+        for (; i < end; ++i) {
+            const uint32_t vaddr = address + static_cast<uint32_t>(i * IMAGE_WORD_STRIDE);
+            writeWordUnlocked(base + AddressSpace::offsetOf(vaddr), words[i]);
         }
     }
 }
+
+void MemoryManager::writeBackLine(uint32_t base, const std::vector<uint32_t>& data) {
+    RangeLock lock(*this, base, data.size(), true);
+    if (base < mainMemoryLimit) {
+        localStats().ram_accesses.fetch_add(1);
+        if (dram) dramAccess(base, nullptr);
+        if (bus) busAccess(data.size(), nullptr);
+        if (noc) writeBackTraffic(base, data.size());
+    } else {
+        localStats().disk_accesses.fetch_add(1);
+    }
+    localStats().write_backs.fetch_add(1);
+    for (size_t i = 0; i < data.size(); ++i) {
+        writeWordUnlocked(base + static_cast<uint32_t>(i), data[i]);
+    }
+}
@@ -1,31 +1,148 @@
 #ifndef MEMORY_MANAGER_HPP
 #define MEMORY_MANAGER_HPP
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <shared_mutex>
+#include <mutex>
+#include <condition_variable>
 #include <atomic>
 #include <chrono>
+#include <vector>
+#include <string>
+#include <unordered_map>
 #include "MAIN_MEMORY.hpp"
 #include "SECONDARY_MEMORY.hpp"
+#include "cache.hpp"
+#include "TLB.hpp"
+#include "PageReplacement.hpp"
+#include "StripedLock.hpp"
+#include "DramModel.hpp"
+#include "BuddyAllocator.hpp"
+#include "MemoryTrace.hpp"
+#include "LoadStoreUnit.hpp"
+#include "FetchBuffer.hpp"
+#include "SharedCache.hpp"
+#include "MemoryBus.hpp"
+#include "Interconnect.hpp"
 
-const size_t MAIN_MEMORY_SIZE = 1024;
+const size_t MAIN_MEMORY_SIZE = DEFAULT_MAIN_MEMORY_SIZE;
+const size_t SECONDARY_MEMORY_SIZE = DEFAULT_SECONDARY_MEMORY_SIZE;
+const uint64_t DEFAULT_WS_WINDOW = 1000;   // Janela do WSClock (acessos do processo)
+const uint32_t SEGMENT_UNAVAILABLE = UINT32_MAX;
+const uint32_t IMAGE_WORD_STRIDE = 4;      // Programas usam endereços de byte: uma palavra a cada 4
 
 // Forward declarations
-class Cache;
 struct PCB;
 
+/**
+ * Latência modelada do disco, somada a memWeights.secondary em cada acesso:
+ * custo fixo (posicionamento) + custo por página transferida, em ciclos simulados
+ */
+struct DiskLatency {
+    uint64_t fixed = 0;
+    uint64_t per_page = 0;
+};
+
 /**
  * Estatísticas globais para análise de performance multicore
+ *
+ * Instantâneo somado dos shards de todas as threads (ver MemoryStatShard)
  */
 struct MemoryStats {
+    uint64_t cache_hits = 0;
+    uint64_t cache_misses = 0;
+    uint64_t ram_accesses = 0;
+    uint64_t disk_accesses = 0;
+    uint64_t lock_contentions = 0;
+    uint64_t total_lock_wait_ns = 0;
+    uint64_t prefetch_issued = 0;
+    uint64_t prefetch_useful = 0;
+    uint64_t write_backs = 0;
+    uint64_t tlb_hits = 0;
+    uint64_t tlb_misses = 0;
+    uint64_t page_faults = 0;
+    uint64_t page_outs = 0;     // Páginas sujas gravadas no swap
+    uint64_t cow_copies = 0;    // Cópias privadas feitas na primeira escrita em página compartilhada
+    uint64_t dram_row_hits = 0;
+    uint64_t dram_row_misses = 0;
+    uint64_t dram_row_conflicts = 0;
+    uint64_t dram_queue_cycles = 0;  // Espera nas filas dos bancos
+    uint64_t numa_remote_accesses = 0;
+    uint64_t ifetch_hits = 0;       // Buscas de instrução que acertaram a L1I
+    uint64_t ifetch_misses = 0;
+    uint64_t fetch_buffer_hits = 0; // Buscas servidas pelo buffer de busca
+    uint64_t l2_hits = 0;
+    uint64_t l2_misses = 0;
+    uint64_t bus_transfers = 0;
+    uint64_t bus_queue_cycles = 0;  // Espera pelo árbitro do barramento
+    uint64_t noc_messages = 0;
+    uint64_t noc_hops = 0;
+    uint64_t noc_wait_cycles = 0;   // Espera por enlaces ocupados da NoC
+    
+    double get_cache_hit_rate() const {
+        uint64_t total = cache_hits + cache_misses;
+        return total > 0 ? (double)cache_hits / total * 100.0 : 0.0;
+    }
+    
+    // Fração dos prefetches emitidos que chegaram a ser usados
+    double get_prefetch_accuracy() const {
+        return prefetch_issued > 0 ? (double)prefetch_useful / prefetch_issued * 100.0 : 0.0;
+    }
+
+    // Fração dos misses originais eliminados pelo prefetch (leituras e escritas, como no PCB)
+    double get_prefetch_coverage() const {
+        uint64_t covered = prefetch_useful;
+        return (covered + cache_misses) > 0 ? (double)covered / (covered + cache_misses) * 100.0 : 0.0;
+    }
+    
+    double get_avg_lock_wait_us() const {
+        return lock_contentions > 0 ? (double)total_lock_wait_ns / lock_contentions / 1000.0 : 0.0;
+    }
+};
+
+/**
+ * Contadores de memória de uma thread
+ *
+ * Cada núcleo incrementa só o seu shard, alinhado à linha de cache do host, então
+ * os incrementos não disputam linhas entre threads (sem false sharing). Os shards
+ * nunca são liberados: quando a thread termina, o próximo núcleo reaproveita o
+ * shard e continua somando, o que mantém as contagens exatas.
+ */
+struct alignas(HOST_CACHE_LINE_BYTES) MemoryStatShard {
     std::atomic<uint64_t> cache_hits{0};
     std::atomic<uint64_t> cache_misses{0};
     std::atomic<uint64_t> ram_accesses{0};
     std::atomic<uint64_t> disk_accesses{0};
     std::atomic<uint64_t> lock_contentions{0};
     std::atomic<uint64_t> total_lock_wait_ns{0};
-    
+    std::atomic<uint64_t> prefetch_issued{0};
+    std::atomic<uint64_t> prefetch_useful{0};
+    std::atomic<uint64_t> write_backs{0};
+    std::atomic<uint64_t> tlb_hits{0};
+    std::atomic<uint64_t> tlb_misses{0};
+    std::atomic<uint64_t> page_faults{0};
+    std::atomic<uint64_t> page_outs{0};
+    std::atomic<uint64_t> cow_copies{0};
+    std::atomic<uint64_t> dram_row_hits{0};
+    std::atomic<uint64_t> dram_row_misses{0};
+    std::atomic<uint64_t> dram_row_conflicts{0};
+    std::atomic<uint64_t> dram_queue_cycles{0};
+    std::atomic<uint64_t> numa_remote_accesses{0};
+    std::atomic<uint64_t> ifetch_hits{0};
+    std::atomic<uint64_t> ifetch_misses{0};
+    std::atomic<uint64_t> fetch_buffer_hits{0};
+    std::atomic<uint64_t> l2_hits{0};
+    std::atomic<uint64_t> l2_misses{0};
+    std::atomic<uint64_t> bus_transfers{0};
+    std::atomic<uint64_t> bus_queue_cycles{0};
+    std::atomic<uint64_t> noc_messages{0};
+    std::atomic<uint64_t> noc_hops{0};
+    std::atomic<uint64_t> noc_wait_cycles{0};
+    std::atomic<bool> in_use{false};   // Atribuído a uma thread viva
+
     void reset() {
         cache_hits = 0;
         cache_misses = 0;
@@ -33,52 +150,385 @@ struct MemoryStats {
         disk_accesses = 0;
         lock_contentions = 0;
         total_lock_wait_ns = 0;
+        prefetch_issued = 0;
+        prefetch_useful = 0;
+        write_backs = 0;
+        tlb_hits = 0;
+        tlb_misses = 0;
+        page_faults = 0;
+        page_outs = 0;
+        cow_copies = 0;
+        dram_row_hits = 0;
+        dram_row_misses = 0;
+        dram_row_conflicts = 0;
+        dram_queue_cycles = 0;
+        numa_remote_accesses = 0;
+        ifetch_hits = 0;
+        ifetch_misses = 0;
+        fetch_buffer_hits = 0;
+        l2_hits = 0;
+        l2_misses = 0;
+        bus_transfers = 0;
+        bus_queue_cycles = 0;
+        noc_messages = 0;
+        noc_hops = 0;
+        noc_wait_cycles = 0;
     }
-    
-    double get_cache_hit_rate() const {
-        uint64_t total = cache_hits + cache_misses;
-        return total > 0 ? (double)cache_hits / total * 100.0 : 0.0;
-    }
-    
-    double get_avg_lock_wait_us() const {
-        return lock_contentions > 0 ? (double)total_lock_wait_ns / lock_contentions / 1000.0 : 0.0;
+
+    void addTo(MemoryStats& total) const {
+        total.cache_hits += cache_hits.load(std::memory_order_relaxed);
+        total.cache_misses += cache_misses.load(std::memory_order_relaxed);
+        total.ram_accesses += ram_accesses.load(std::memory_order_relaxed);
+        total.disk_accesses += disk_accesses.load(std::memory_order_relaxed);
+        total.lock_contentions += lock_contentions.load(std::memory_order_relaxed);
+        total.total_lock_wait_ns += total_lock_wait_ns.load(std::memory_order_relaxed);
+        total.prefetch_issued += prefetch_issued.load(std::memory_order_relaxed);
+        total.prefetch_useful += prefetch_useful.load(std::memory_order_relaxed);
+        total.write_backs += write_backs.load(std::memory_order_relaxed);
+        total.tlb_hits += tlb_hits.load(std::memory_order_relaxed);
+        total.tlb_misses += tlb_misses.load(std::memory_order_relaxed);
+        total.page_faults += page_faults.load(std::memory_order_relaxed);
+        total.page_outs += page_outs.load(std::memory_order_relaxed);
+        total.cow_copies += cow_copies.load(std::memory_order_relaxed);
+        total.dram_row_hits += dram_row_hits.load(std::memory_order_relaxed);
+        total.dram_row_misses += dram_row_misses.load(std::memory_order_relaxed);
+        total.dram_row_conflicts += dram_row_conflicts.load(std::memory_order_relaxed);
+        total.dram_queue_cycles += dram_queue_cycles.load(std::memory_order_relaxed);
+        total.numa_remote_accesses += numa_remote_accesses.load(std::memory_order_relaxed);
+        total.ifetch_hits += ifetch_hits.load(std::memory_order_relaxed);
+        total.ifetch_misses += ifetch_misses.load(std::memory_order_relaxed);
+        total.fetch_buffer_hits += fetch_buffer_hits.load(std::memory_order_relaxed);
+        total.l2_hits += l2_hits.load(std::memory_order_relaxed);
+        total.l2_misses += l2_misses.load(std::memory_order_relaxed);
+        total.bus_transfers += bus_transfers.load(std::memory_order_relaxed);
+        total.bus_queue_cycles += bus_queue_cycles.load(std::memory_order_relaxed);
+        total.noc_messages += noc_messages.load(std::memory_order_relaxed);
+        total.noc_hops += noc_hops.load(std::memory_order_relaxed);
+        total.noc_wait_cycles += noc_wait_cycles.load(std::memory_order_relaxed);
     }
 };
 
+/**
+ * Partição da máquina em nós NUMA
+ *
+ * A RAM é dividida em fatias contíguas (múltiplas da página), uma por nó. Cada nó
+ * tem seu próprio domínio de travas e um conjunto de núcleos; acessar a fatia de
+ * outro nó custa `remote_latency` ciclos a mais.
+ */
+struct NumaConfig {
+    size_t nodes = 1;
+    uint64_t remote_latency = 0;
+    std::vector<int> core_nodes;   // Nó de cada núcleo (vazio = blocos contíguos de núcleos)
+};
+
+/**
+ * Posição de um núcleo no log de quadros despejados (ver beginQuantum)
+ */
+struct EvictionCursor {
+    uint64_t epoch = 0;
+    size_t index = 0;
+};
+
 /**
  * MemoryManager - RAM/Disco compartilhados + Cache L1 privada thread_local
  */
 class MemoryManager {
 public:
-    MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize);
+    MemoryManager(size_t mainMemorySize, size_t secondaryMemorySize,
+                  SparseBacking ramBacking = SparseBacking::Heap,
+                  const std::string& diskFile = "");
 
     uint64_t getUsedMainMemory() const;
     uint64_t getUsedSecondaryMemory() const;
-    uint64_t getTotalCacheHits() const { return global_stats.cache_hits.load(); }
-    uint64_t getTotalCacheMisses() const { return global_stats.cache_misses.load(); }
+    uint64_t getTotalCacheHits() const { return getStats().cache_hits; }
+    uint64_t getTotalCacheMisses() const { return getStats().cache_misses; }
     size_t getMainMemoryCapacity() const { return mainMemoryLimit; }
     size_t getSecondaryMemoryCapacity() const;
+    size_t getTotalCapacity() const { return mainMemoryLimit + getSecondaryMemoryCapacity(); }
 
     static void setThreadCache(Cache* l1_cache);
     static Cache* getThreadCache();
+    // L1I e buffer de busca do núcleo (nulos: a busca usa a L1 de dados, como read())
+    static void setThreadICache(Cache* l1i_cache, FetchBuffer* fetch_buffer);
+    static void setThreadTLB(TLB* tlb);
+
+    // Store buffer e MSHRs dos núcleos (desligados por padrão: acessos bloqueantes)
+    void setLsuConfig(const LsuConfig& config) { lsuConfig = config; }
+    const LsuConfig& getLsuConfig() const { return lsuConfig; }
+    static void setThreadLsu(LoadStoreUnit* lsu);
+
+    // Memória virtual com paginação por demanda: a RAM vira um conjunto de quadros e o
+    // disco guarda as páginas fora da RAM (swap)
+    void enableVirtualMemory(const TLBConfig& config,
+                             PageReplacementPolicy policy = PageReplacementPolicy::FIFO,
+                             uint64_t wsWindow = DEFAULT_WS_WINDOW);
+    bool isVirtualMemoryEnabled() const { return vmEnabled; }
+    const TLBConfig& getTLBConfig() const { return tlbConfig; }
+    PageReplacementPolicy getPageReplacementPolicy() const { return replacementPolicy; }
+    size_t getFrameCount() const { return frames.size(); }
+    void attachAddressSpace(PCB& process);
+    // ASID único do processo (tag das linhas da L1), também sem memória virtual
+    uint16_t assignAsid(PCB& process);
+
+    // Despeja todas as páginas residentes do processo para o swap
+    void swapOut(PCB& process);
+
+    // Copy-on-write: `target` passa a mapear as páginas da imagem de `source` (mesmo
+    // programa) nos mesmos slots de swap, sem carregar outra cópia. A imagem de origem
+    // precisa estar toda no swap (logo após loadImage ou swapOut); retorna false caso contrário.
+    bool shareImage(const PCB& source, PCB& target);
+    // Inspeção do copy-on-write: PTEs que apontam para o slot e se há um quadro com a
+    // cópia limpa do slot mapeado por mais de um processo
+    uint32_t swapSlotRefs(uint32_t slot);
+    bool hasSharedFrame(uint32_t slot);
+
+    // Início/fim de quantum em um núcleo: enquanto roda, as páginas do processo não
+    // são despejadas por outros núcleos; no início a L1 descarta quadros despejados
+    // e segmentos liberados
+    void beginQuantum(PCB& process, Cache* l1_cache, EvictionCursor& cursor, Cache* l1i_cache = nullptr);
+    void endQuantum(PCB& process);
 
     uint32_t read(uint32_t address, PCB& process);
     void write(uint32_t address, uint32_t data, PCB& process);
+    // LW: com a LoadStoreUnit do núcleo o miss não para o pipeline; só quem ler
+    // `dest_register` espera o dado. Sem ela é igual a read().
+    uint32_t load(uint32_t address, PCB& process, int dest_register);
+    // Busca de instrução: buffer de busca -> L1I -> memória, com contadores próprios
+    // (ifetch_* no PCB) fora de mem_reads/cache_hits. Sem L1I separada é igual a read().
+    uint32_t fetch(uint32_t address, PCB& process);
+
+    // Carga da imagem de um programa (estilo DMA): a palavra i vai para
+    // address + i * IMAGE_WORD_STRIDE sob uma única trava, sem passar pela L1 e sem
+    // contar no PCB. Com memória virtual as páginas vão direto para o swap do processo.
+    void loadImage(uint32_t address, const uint32_t* words, size_t count, PCB& process);
+
+    // Write-back de uma linha suja da L1 (não contabiliza no PCB)
+    void writeBackLine(uint32_t base, const std::vector<uint32_t>& data);
+
+    // Configuração das caches L1 criadas pelos núcleos
+    void setL1Config(const CacheConfig& config) { l1Config = config; }
+    const CacheConfig& getL1Config() const { return l1Config; }
+    // L1I dos núcleos: lines == 0 mantém a L1 unificada (instruções e dados juntos)
+    void setL1IConfig(const CacheConfig& config) { l1iConfig = config; }
+    const CacheConfig& getL1IConfig() const { return l1iConfig; }
+    bool hasSplitL1() const { return l1iConfig.lines > 0; }
+    void setFetchBufferLines(size_t lines) { fetchBufferLines = lines; }
+    size_t getFetchBufferLines() const { return fetchBufferLines; }
+
+    // L2 compartilhada entre os núcleos, particionada por vias (desligada por padrão)
+    void enableSharedCache(const SharedCacheConfig& config) { l2 = std::make_unique<SharedCache>(config); }
+    SharedCache* getSharedCache() const { return l2.get(); }
+    // Classe pedida explicitamente (cache_class do PCB ou --l2-class): nunca é dada como
+    // classe própria a um processo. Chamar para todas antes de admitir o primeiro.
+    void reserveCacheClass(int clos);
+    // Resolve a classe de serviço da L2 pedida no PCB (cache_class/cache_mask) e
+    // aplica a máscara; chamar ao admitir o processo
+    void assignCacheClass(PCB& process);
+
+    // Latência do disco em ciclos simulados (além de memWeights.secondary)
+    void setDiskLatency(const DiskLatency& latency) { diskLatency = latency; }
+    const DiskLatency& getDiskLatency() const { return diskLatency; }
+    uint64_t diskAccessCost(uint32_t address, size_t words) const;
+
+    // Modelo de DRAM por trás da RAM: sem ele cada acesso custa memWeights.primary
+    void enableDram(const DramConfig& config) { dram = std::make_unique<DramModel>(config); }
+    const DramModel* getDram() const { return dram.get(); }
+    uint64_t dramClock() const { return dram ? dram->clock() : 0; }
+
+    // Barramento entre os núcleos e a RAM (largura e árbitro); sem ele os núcleos
+    // só disputam as travas do host
+    void enableBus(const BusConfig& config) { bus = std::make_unique<MemoryBus>(config); }
+    const MemoryBus* getBus() const { return bus.get(); }
+    uint64_t busClock() const { return bus ? bus->clock() : 0; }
+
+    // Rede-em-chip (anel ou malha) com um tile por núcleo: misses da L1 e write-backs
+    // viajam até o banco da L2 e o controlador de memória do endereço
+    void enableInterconnect(const NocConfig& config, int numCores) {
+        noc = std::make_unique<Interconnect>(config, static_cast<size_t>(std::max(numCores, 1)));
+    }
+    const Interconnect* getInterconnect() const { return noc.get(); }
+    // Maior relógio visto pela DRAM, barramento e NoC (núcleo ocioso alcança esse tempo)
+    uint64_t memoryClock() const { return std::max({dramClock(), busClock(), noc ? noc->clock() : 0}); }
+
+    // Segmentos físicos para imagens de processos (sem memória virtual): buddy por nó
+    // NUMA da RAM, com o disco como último recurso. Retorna SEGMENT_UNAVAILABLE se não couber.
+    uint32_t allocateSegment(size_t words, int preferredNode = -1, bool allowDisk = true);
+    // Devolve o segmento do processo (segment_base_addr/segment_limit) ao terminar
+    void releaseProcessMemory(PCB& process);
+    FragmentationReport getFragmentation(bool disk = false) const;
+
+    // Relógio simulado do núcleo desta thread (instante de chegada dos pedidos à DRAM)
+    static void setThreadClock(const uint64_t* clock);
+
+    // Trace binário dos acessos (PC, endereço físico, R/W, PID, núcleo) para bin/cachesim.
+    // Chamar antes de criar os núcleos; cada um grava pelo seu TraceBuffer.
+    void enableTrace(const std::string& path) { trace = std::make_unique<TraceWriter>(path); }
+    TraceWriter* getTrace() const { return trace.get(); }
+    static void setThreadTrace(TraceBuffer* buffer);
+
+    // Curvas de miss por processo: distância de reuso amostrada 1 a cada `sample_period`
+    // linhas da L1. attachReuseProfiler não faz nada se o perfil não foi ativado; chamar
+    // depois de carregar a imagem, para medir só os acessos do programa.
+    void enableReuseProfiling(uint32_t sample_period) { reuseSamplePeriod = sample_period; }
+    void attachReuseProfiler(PCB& process) const;
+
+    // NUMA: chamar antes de carregar processos (e antes de enableVirtualMemory)
+    void enableNuma(const NumaConfig& config, int numCores);
+    size_t getNumaNodes() const { return numaNodes; }
+    const NumaConfig& getNumaConfig() const { return numaConfig; }
+    size_t nodeBase(size_t node) const { return node * nodeSlice; }
+    int nodeOfAddress(uint32_t address) const;   // -1 para o disco
+    int nodeOfCore(int coreId) const;
+    // Nó com mais páginas do processo na RAM (-1 se nenhuma está residente)
+    int homeNode(const PCB& process);
+    // Nó do núcleo que executa esta thread (-1 fora dos núcleos)
+    static void setThreadNode(int node);
+    // Núcleo que executa esta thread (requisitante no árbitro do barramento)
+    static void setThreadCore(int core);
     
     size_t getMainMemoryLimit() const { return mainMemoryLimit; }
     
-    // Estatísticas globais
-    static MemoryStats& getStats() { return global_stats; }
-    static void resetStats() { global_stats.reset(); }
+    // Estatísticas globais (soma dos shards no momento da leitura)
+    static MemoryStats getStats();
+    static void resetStats();
 
 private:
     std::unique_ptr<MAIN_MEMORY> mainMemory;
     std::unique_ptr<SECONDARY_MEMORY> secondaryMemory;
     size_t mainMemoryLimit;
+    CacheConfig l1Config;
+    CacheConfig l1iConfig;
+    size_t fetchBufferLines = FETCH_BUFFER_LINES;
+    LsuConfig lsuConfig;
+    DiskLatency diskLatency;
+    std::unique_ptr<DramModel> dram;
+    std::unique_ptr<MemoryBus> bus;
+    std::unique_ptr<Interconnect> noc;
+    std::unique_ptr<SharedCache> l2;
+    int nextPrivateClass = L2_MAX_CLASSES - 1;   // Classes próprias de processos, de cima para baixo
+    std::array<bool, L2_MAX_CLASSES> reservedClasses{};   // Pedidas explicitamente
+    std::mutex class_mutex;
+    std::unique_ptr<TraceWriter> trace;
+    uint32_t reuseSamplePeriod = 0;   // 0 = sem perfil de reuso
+
+    // NUMA
+    size_t numaNodes = 1;
+    size_t nodeSlice;                // Endereços da RAM por nó
+    NumaConfig numaConfig;
+    int numaCores = 1;
+
+    // Memória virtual
+    bool vmEnabled = false;
+    TLBConfig tlbConfig;
+    std::mutex vm_mutex;             // Protege tabelas de páginas, quadros e swap
+    std::condition_variable frame_released;  // Quadro livre ou processo fora da CPU (com vm_mutex)
+    uint16_t nextAsid = 1;
+    PageReplacementPolicy replacementPolicy = PageReplacementPolicy::FIFO;
+    std::unique_ptr<PageReplacer> replacer;
+    std::vector<FrameInfo> frames;           // Um por página da RAM
+    std::vector<std::vector<uint32_t>> freeFrames;  // Por nó (first-touch no nó do núcleo)
+    std::vector<size_t> nextFrame;                   // Por nó: quadros ainda nunca usados
+    uint64_t frameTick = 0;
+    uint32_t nextSwapSlot = 0;
+    std::vector<uint32_t> swapRefs;          // PTEs que apontam para cada slot de swap
+    std::unordered_map<uint32_t, uint32_t> sharedSlotFrames;  // Slot COW -> quadro com a cópia limpa
+    std::vector<uint32_t> evictedFrames;     // Log de páginas físicas lido pelos núcleos em beginQuantum
+    uint64_t evictionEpoch = 0;
+
+    // Segmentos físicos (imagens de processos sem memória virtual)
+    mutable std::mutex segment_mutex;
+    std::vector<std::unique_ptr<BuddyAllocator>> ramSegments;   // Um por nó NUMA
+    std::unique_ptr<BuddyAllocator> diskSegments;
+
+    // Acesso síncrono; read/load/write trocam a latência cobrada pela espera da LSU.
+    // `l1_miss` (opcional) recebe se a palavra precisou sair da L1 de dados.
+    uint32_t readAccess(uint32_t address, PCB& process, bool* l1_miss = nullptr);
+    void writeAccess(uint32_t address, uint32_t data, PCB& process);
+    uint32_t fetchAccess(uint32_t address, PCB& process);
+    // Descarta a faixa nas caches deste núcleo (L1 com write-back, L1I e buffer de busca)
+    void invalidateThreadCaches(uint32_t base, size_t size);
+    uint32_t timedLoad(uint32_t address, PCB& process, int dest_register);
+    void chargeStall(PCB& process, uint64_t latency, uint64_t stall);
+
+    uint32_t readWordUnlocked(uint32_t address) const;
+    void writeWordUnlocked(uint32_t address, uint32_t data);
+    void readLineUnlocked(uint32_t base, size_t line_size, std::vector<uint32_t>& out) const;
+    void chargeMemoryAccess(uint32_t address, PCB& process, size_t words = 1);
+    uint64_t dramAccess(uint32_t address, PCB* process);
+    uint64_t busAccess(size_t words, PCB* process);
+    size_t controllerOf(uint32_t address) const;
+    uint64_t nocSend(size_t src, size_t dst, size_t words, uint64_t now, PCB* process);
+    uint64_t missTraffic(uint32_t base, size_t words, bool via_l2, bool l2_hit, PCB* process);
+    void writeBackTraffic(uint32_t base, size_t words);
+    uint32_t fillLine(Cache* l1_cache, uint32_t address, PCB& process);
+    void issuePrefetches(Cache* l1_cache, uint32_t address, CacheLookup result, PCB& process);
+    bool translate(uint32_t vaddr, PCB& process, bool is_write, uint32_t& paddr);
+    PageTableEntry* handlePageFault(AddressSpace& space, uint32_t vpn, PCB& process, uint64_t& cost);
+    size_t obtainFrame(AddressSpace& space, PCB& process, uint64_t& cost);
+    void initFrameLists();
+    size_t nodeOfFrame(size_t index) const { return numaNodes > 1 ? index * VM_PAGE_SIZE / nodeSlice : 0; }
+    uint64_t evictFrame(size_t index, PCB& process);
+    void detachMapping(size_t index, const AddressSpace& space);
+    bool mapsFrame(size_t index, const AddressSpace& space) const;
+    void claimFrame(size_t index, AddressSpace& space, uint32_t vpn, PageTableEntry& pte);
+    PageTableEntry* breakCow(AddressSpace& space, uint32_t vpn, PageTableEntry& pte, PCB& process, uint64_t& cost);
+    void logEvictedPage(uint32_t page);
+    void initSegments();
+    uint32_t allocateSwapSlot();
+    uint32_t swapSlotAddress(uint32_t slot) const { return static_cast<uint32_t>(mainMemoryLimit + size_t(slot) * VM_PAGE_SIZE); }
+    uint64_t pageTransferCost(uint32_t slot, const PCB& process) const;
+    void copyPage(uint32_t from, uint32_t to);
+    void clearPage(uint32_t base);
+
+    // Travas por página: RAM e disco são numerados em sequência (o disco começa na
+    // página seguinte à última da RAM, mesmo se o limite não for múltiplo da página).
+    // Com NUMA cada nó é um domínio de travas separado e o disco é o último.
+    size_t lockPageOf(uint32_t address) const;
+    size_t lockDomainOf(size_t address) const;
+    size_t lockDomainEnd(size_t domain) const;   // Último endereço do domínio
+
+    // Segura as travas das páginas das faixas até o fim do escopo, somando a espera
+    // nas estatísticas. Domínios são travados em ordem crescente (sem deadlock).
+    class RangeLock {
+    public:
+        RangeLock(MemoryManager& manager, uint32_t address, size_t words, bool exclusive);
+        // Duas faixas do mesmo tamanho (cópia de página entre RAM e swap)
+        RangeLock(MemoryManager& manager, uint32_t first, uint32_t second, size_t words, bool exclusive);
+        ~RangeLock();
+        RangeLock(const RangeLock&) = delete;
+        RangeLock& operator=(const RangeLock&) = delete;
+
+    private:
+        struct Held {
+            size_t domain;
+            uint64_t mask;
+        };
+        static constexpr size_t MAX_DOMAINS = 4;
+
+        void add(uint32_t address, size_t words);
+        void acquire();
+
+        MemoryManager& manager;
+        std::array<Held, MAX_DOMAINS> held;
+        size_t count = 0;
+        bool exclusive;
+    };
     
     static thread_local Cache* current_thread_cache;
-    mutable std::shared_mutex memory_mutex;
-    static MemoryStats global_stats;
+    static thread_local Cache* current_thread_icache;
+    static thread_local FetchBuffer* current_thread_fetch_buffer;
+    static thread_local TLB* current_thread_tlb;
+    static thread_local const uint64_t* current_thread_clock;
+    static thread_local TraceBuffer* current_thread_trace;
+    static thread_local LoadStoreUnit* current_thread_lsu;
+    static thread_local int current_thread_node;
+    static thread_local int current_thread_core;
+    std::vector<std::unique_ptr<StripedLock>> lock_domains;
+    static MemoryStatShard& localStats();
+
+    // Registro dos shards de estatísticas (um por thread viva, reaproveitados)
+    static std::mutex stats_mutex;
+    static std::vector<std::unique_ptr<MemoryStatShard>> stat_shards;
     
     friend class Core;
 };
@@ -1,5 +1,6 @@
 #include "MemoryMetrics.hpp"
 #include <chrono>
+#include <filesystem>
 
 MemoryMetrics::MemoryMetrics(const std::string& log_file)
     : log_file(log_file) {}
@@ -13,10 +14,52 @@ void MemoryMetrics::record(uint64_t used_main, uint64_t used_secondary, uint64_t
 
 void MemoryMetrics::flush() {
     std::lock_guard<std::mutex> lock(mtx);
+    const std::filesystem::path dir = std::filesystem::path(log_file).parent_path();
+    if (!dir.empty()) std::filesystem::create_directories(dir);
     std::ofstream out(log_file);
     out << "timestamp_ms,used_main_memory,used_secondary_memory,cache_hits,cache_misses\n";
     for (const auto& snap : snapshots) {
         out << snap.timestamp_ms << "," << snap.used_main_memory << "," << snap.used_secondary_memory << "," << snap.cache_hits << "," << snap.cache_misses << "\n";
     }
     out.close();
+
+    if (!curves.empty()) {
+        std::ofstream curve_out(get_curve_file());
+        curve_out << "pid,name,cache_lines,miss_ratio,accesses,sampled_accesses\n";
+        for (const auto& curve : curves) {
+            for (const auto& point : curve.points) {
+                curve_out << curve.pid << "," << curve.name << "," << point.lines << "," << point.miss_ratio << ","
+                          << curve.accesses << "," << curve.sampled << "\n";
+            }
+        }
+    }
+
+    if (cache_sets.empty()) return;
+    std::ofstream sets_out(get_sets_file());
+    sets_out << "core,set,accesses,misses,compulsory,capacity,conflict\n";
+    for (const auto& [core, sets] : cache_sets) {
+        for (size_t set = 0; set < sets.size(); ++set) {
+            const CacheSetStats& stats = sets[set];
+            sets_out << core << "," << set << "," << stats.accesses << "," << stats.misses << ","
+                     << stats.compulsory << "," << stats.capacity << "," << stats.conflict << "\n";
+        }
+    }
+}
+
+void MemoryMetrics::recordMissRatioCurve(const MissRatioCurve& curve) {
+    std::lock_guard<std::mutex> lock(mtx);
+    curves.push_back(curve);
+}
+
+void MemoryMetrics::recordCacheSets(int core, const std::vector<CacheSetStats>& sets) {
+    std::lock_guard<std::mutex> lock(mtx);
+    cache_sets.emplace_back(core, sets);
+}
+
+std::string MemoryMetrics::get_sets_file() const {
+    return (std::filesystem::path(log_file).parent_path() / "cache_sets.csv").string();
+}
+
+std::string MemoryMetrics::get_curve_file() const {
+    return (std::filesystem::path(log_file).parent_path() / "miss_ratio_curves.csv").string();
 }
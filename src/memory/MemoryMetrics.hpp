@@ -3,6 +3,8 @@
 #include <fstream>
 #include <string>
 #include <mutex>
+#include "ReuseProfiler.hpp"
+#include "cache.hpp"
 
 struct MemorySnapshot {
     uint64_t timestamp_ms;
@@ -16,11 +18,20 @@ class MemoryMetrics {
 public:
     MemoryMetrics(const std::string& log_file);
     void record(uint64_t used_main, uint64_t used_secondary, uint64_t cache_hits, uint64_t cache_misses);
+    // Curva de miss de um processo; flush() grava todas em miss_ratio_curves.csv,
+    // no mesmo diretório do log de utilização
+    void recordMissRatioCurve(const MissRatioCurve& curve);
+    // Contadores por conjunto da L1 de um núcleo (mapa de calor); vão para cache_sets.csv
+    void recordCacheSets(int core, const std::vector<CacheSetStats>& sets);
     void flush();
     size_t get_sample_count() const { return snapshots.size(); }
     std::string get_log_file() const { return log_file; }
+    std::string get_curve_file() const;
+    std::string get_sets_file() const;
 private:
     std::vector<MemorySnapshot> snapshots;
+    std::vector<MissRatioCurve> curves;
+    std::vector<std::pair<int, std::vector<CacheSetStats>>> cache_sets;
     std::string log_file;
     std::mutex mtx;
 };
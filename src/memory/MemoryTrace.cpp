@@ -0,0 +1,55 @@
+#include "MemoryTrace.hpp"
+#include <cstring>
+#include <stdexcept>
+
+TraceWriter::TraceWriter(const std::string& path) : path(path) {
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("TraceWriter - não foi possível criar '" + path + "'");
+    }
+    std::fwrite(TRACE_MAGIC, 1, 8, file);
+}
+
+TraceWriter::~TraceWriter() {
+    if (file) std::fclose(file);
+}
+
+void TraceWriter::append(const TraceRecord* records, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    written += std::fwrite(records, sizeof(TraceRecord), count, file);
+}
+
+TraceBuffer::TraceBuffer(TraceWriter& writer, int core)
+    : writer(writer), core(static_cast<uint8_t>(core)) {
+    pending.reserve(TRACE_BUFFER_RECORDS);
+}
+
+void TraceBuffer::record(uint32_t pc, uint32_t address, int pid, uint8_t flags) {
+    pending.push_back(TraceRecord{pc, address, static_cast<uint16_t>(pid), core, flags});
+    if (pending.size() >= TRACE_BUFFER_RECORDS) flush();
+}
+
+void TraceBuffer::flush() {
+    if (pending.empty()) return;
+    writer.append(pending.data(), pending.size());
+    pending.clear();
+}
+
+std::vector<TraceRecord> readTrace(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) throw std::runtime_error("Não foi possível abrir: " + path);
+
+    char magic[8];
+    if (std::fread(magic, 1, 8, file) != 8 || std::memcmp(magic, TRACE_MAGIC, 8) != 0) {
+        std::fclose(file);
+        throw std::runtime_error("Arquivo de trace inválido: " + path);
+    }
+    std::vector<TraceRecord> records;
+    TraceRecord block[TRACE_BUFFER_RECORDS];
+    size_t count;
+    while ((count = std::fread(block, sizeof(TraceRecord), TRACE_BUFFER_RECORDS, file)) > 0) {
+        records.insert(records.end(), block, block + count);
+    }
+    std::fclose(file);
+    return records;
+}
@@ -0,0 +1,82 @@
+#ifndef MEMORY_TRACE_HPP
+#define MEMORY_TRACE_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define TRACE_MAGIC "VNTRACE1"     // Cabeçalho do arquivo (8 bytes)
+#define TRACE_BUFFER_RECORDS 4096  // Registros acumulados por núcleo antes de gravar
+
+/**
+ * Um acesso à memória no trace binário (12 bytes, little-endian do host)
+ *
+ * `address` é o endereço físico (depois da tradução), o mesmo usado pela L1.
+ */
+#pragma pack(push, 1)
+struct TraceRecord {
+    uint32_t pc;
+    uint32_t address;
+    uint16_t pid;
+    uint8_t core;
+    uint8_t flags;   // TraceFlags
+};
+#pragma pack(pop)
+static_assert(sizeof(TraceRecord) == 12, "TraceRecord deve ter 12 bytes");
+
+enum TraceFlags : uint8_t {
+    TRACE_WRITE = 1,
+    TRACE_FETCH = 2   // Busca de instrução pela L1I separada
+};
+
+/**
+ * TraceWriter - Arquivo de trace compartilhado pelos núcleos
+ *
+ * Os núcleos gravam blocos inteiros (TraceBuffer), então a ordem só é garantida
+ * dentro do fluxo de cada núcleo, que é o que importa para caches privadas.
+ */
+class TraceWriter {
+public:
+    explicit TraceWriter(const std::string& path);
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    void append(const TraceRecord* records, size_t count);
+    uint64_t records() const { return written; }
+    const std::string& getPath() const { return path; }
+
+private:
+    std::string path;
+    std::FILE* file = nullptr;
+    std::mutex mutex;
+    uint64_t written = 0;
+};
+
+/**
+ * TraceBuffer - Registros de um núcleo, gravados no TraceWriter em blocos
+ */
+class TraceBuffer {
+public:
+    TraceBuffer(TraceWriter& writer, int core);
+    ~TraceBuffer() { flush(); }
+
+    void record(uint32_t pc, uint32_t address, int pid, uint8_t flags);
+    void flush();
+
+private:
+    TraceWriter& writer;
+    uint8_t core;
+    std::vector<TraceRecord> pending;
+};
+
+/**
+ * Leitura de um trace inteiro; lança std::runtime_error se o arquivo for inválido
+ */
+std::vector<TraceRecord> readTrace(const std::string& path);
+
+#endif // MEMORY_TRACE_HPP
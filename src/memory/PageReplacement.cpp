@@ -0,0 +1,110 @@
+#include "PageReplacement.hpp"
+#include <algorithm>
+#include <cctype>
+
+std::unique_ptr<PageReplacer> PageReplacer::create(PageReplacementPolicy policy, uint64_t ws_window) {
+    switch (policy) {
+        case PageReplacementPolicy::Clock:
+            return std::make_unique<ClockReplacer>();
+        case PageReplacementPolicy::WSClock:
+            return std::make_unique<WSClockReplacer>(ws_window);
+        case PageReplacementPolicy::Aging:
+            return std::make_unique<AgingReplacer>();
+        default:
+            return std::make_unique<FIFOReplacer>();
+    }
+}
+
+PageReplacementPolicy PageReplacer::parsePolicy(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    if (lower == "clock") return PageReplacementPolicy::Clock;
+    if (lower == "wsclock") return PageReplacementPolicy::WSClock;
+    if (lower == "aging" || lower == "lru") return PageReplacementPolicy::Aging;
+    return PageReplacementPolicy::FIFO;
+}
+
+const char* PageReplacer::policyName(PageReplacementPolicy policy) {
+    switch (policy) {
+        case PageReplacementPolicy::Clock:   return "clock";
+        case PageReplacementPolicy::WSClock: return "wsclock";
+        case PageReplacementPolicy::Aging:   return "aging";
+        default:                             return "fifo";
+    }
+}
+
+// ============= FIFO =============
+
+size_t FIFOReplacer::selectVictim(std::vector<FrameInfo>& frames, const Filter& evictable) {
+    size_t victim = NO_VICTIM;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (!evictable(i)) continue;
+        if (victim == NO_VICTIM || frames[i].loaded_at < frames[victim].loaded_at) victim = i;
+    }
+    return victim;
+}
+
+// ============= Clock =============
+
+size_t ClockReplacer::selectVictim(std::vector<FrameInfo>& frames, const Filter& evictable) {
+    // Duas voltas bastam: na primeira todos os bits R são zerados
+    for (size_t step = 0; step < 2 * frames.size(); ++step) {
+        const size_t i = hand;
+        hand = (hand + 1) % frames.size();
+        if (!evictable(i)) continue;
+        if (frames[i].pte->referenced.exchange(false)) continue;
+        return i;
+    }
+    return NO_VICTIM;
+}
+
+// ============= WSClock =============
+
+WSClockReplacer::WSClockReplacer(uint64_t window) : window(window) {}
+
+size_t WSClockReplacer::selectVictim(std::vector<FrameInfo>& frames, const Filter& evictable) {
+    size_t old_dirty = NO_VICTIM;  // Fora do working set, mas exige write-back
+    size_t fallback = NO_VICTIM;   // Sem uso recente, ainda dentro da janela
+
+    for (size_t step = 0; step < 2 * frames.size(); ++step) {
+        const size_t i = hand;
+        hand = (hand + 1) % frames.size();
+        if (!evictable(i)) continue;
+
+        FrameInfo& frame = frames[i];
+        const uint64_t now = frame.owner->virtualTime();
+        if (frame.pte->referenced.exchange(false)) {
+            frame.last_use = now;
+            continue;
+        }
+        if (now - frame.last_use > window) {
+            if (!frame.pte->dirty.load()) return i;
+            if (old_dirty == NO_VICTIM) old_dirty = i;
+        } else if (fallback == NO_VICTIM) {
+            fallback = i;
+        }
+    }
+    return old_dirty != NO_VICTIM ? old_dirty : fallback;
+}
+
+// ============= Aging (LRU aproximado) =============
+
+size_t AgingReplacer::selectVictim(std::vector<FrameInfo>& frames, const Filter& evictable) {
+    // "Tique" do envelhecimento a cada falta de página
+    for (auto& frame : frames) {
+        if (!frame.used) continue;
+        const uint8_t referenced = frame.pte->referenced.exchange(false) ? 0x80 : 0x00;
+        frame.age = static_cast<uint8_t>((frame.age >> 1) | referenced);
+    }
+
+    size_t victim = NO_VICTIM;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (!evictable(i)) continue;
+        if (victim == NO_VICTIM || frames[i].age < frames[victim].age ||
+            (frames[i].age == frames[victim].age && frames[i].loaded_at < frames[victim].loaded_at)) {
+            victim = i;
+        }
+    }
+    return victim;
+}
@@ -0,0 +1,112 @@
+#ifndef PAGE_REPLACEMENT_HPP
+#define PAGE_REPLACEMENT_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AddressSpace.hpp"
+
+#define NO_VICTIM SIZE_MAX
+
+enum class PageReplacementPolicy {
+    FIFO,     // Quadro carregado há mais tempo
+    Clock,    // Segunda chance com ponteiro circular
+    WSClock,  // Clock + janela de working set, prefere páginas limpas
+    Aging     // LRU aproximado: contador de idade deslocado a cada falta
+};
+
+/**
+ * Outro espaço que mapeia o mesmo quadro (página copy-on-write compartilhada)
+ */
+struct FrameMapping {
+    AddressSpace* space;
+    PageTableEntry* pte;
+};
+
+/**
+ * Entrada da tabela de quadros da RAM (memória virtual com paginação por demanda)
+ *
+ * `owner`/`pte` é o primeiro mapeamento; páginas COW de imagens iguais podem ter
+ * outros em `sharers`. As políticas olham só a PTE do dono (o MemoryManager junta
+ * nela os bits R dos demais antes de escolher a vítima).
+ */
+struct FrameInfo {
+    bool used = false;
+    AddressSpace* owner = nullptr;
+    uint32_t vpn = 0;
+    PageTableEntry* pte = nullptr;
+    std::vector<FrameMapping> sharers;
+    uint64_t loaded_at = 0;   // FIFO: instante da carga
+    uint64_t last_use = 0;    // WSClock: último uso observado (tempo virtual do dono)
+    uint8_t age = 0;          // Aging: bit R acumulado nos bits mais altos
+};
+
+/**
+ * PageReplacer - Interface plugável de substituição de páginas
+ *
+ * Escolhe o quadro vítima entre os que `evictable` permite, usando os bits R/M
+ * das PTEs. O tempo usado pelo WSClock é o tempo virtual do processo dono do
+ * quadro (acessos traduzidos por ele).
+ */
+class PageReplacer {
+public:
+    using Filter = std::function<bool(size_t)>;
+
+    virtual ~PageReplacer() = default;
+
+    // Retorna o índice do quadro vítima, ou NO_VICTIM se nenhum puder sair
+    virtual size_t selectVictim(std::vector<FrameInfo>& frames, const Filter& evictable) = 0;
+    virtual const char* name() const = 0;
+
+    static std::unique_ptr<PageReplacer> create(PageReplacementPolicy policy, uint64_t ws_window);
+    static PageReplacementPolicy parsePolicy(const std::string& name);
+    static const char* policyName(PageReplacementPolicy policy);
+};
+
+class FIFOReplacer : public PageReplacer {
+public:
+    size_t selectVictim(std::vector<FrameInfo>& frames, const Filter& evictable) override;
+    const char* name() const override { return "fifo"; }
+};
+
+/**
+ * ClockReplacer - Segunda chance: páginas com R=1 perdem o bit e são puladas
+ */
+class ClockReplacer : public PageReplacer {
+public:
+    size_t selectVictim(std::vector<FrameInfo>& frames, const Filter& evictable) override;
+    const char* name() const override { return "clock"; }
+
+private:
+    size_t hand = 0;
+};
+
+/**
+ * WSClockReplacer - Páginas fora da janela de working set são candidatas;
+ * entre elas as limpas saem primeiro (evitam escrita no disco)
+ */
+class WSClockReplacer : public PageReplacer {
+public:
+    explicit WSClockReplacer(uint64_t window);
+    size_t selectVictim(std::vector<FrameInfo>& frames, const Filter& evictable) override;
+    const char* name() const override { return "wsclock"; }
+
+private:
+    uint64_t window;
+    size_t hand = 0;
+};
+
+/**
+ * AgingReplacer - LRU aproximado: a cada falta o bit R entra no bit mais alto
+ * da idade e a menor idade sai
+ */
+class AgingReplacer : public PageReplacer {
+public:
+    size_t selectVictim(std::vector<FrameInfo>& frames, const Filter& evictable) override;
+    const char* name() const override { return "aging"; }
+};
+
+#endif // PAGE_REPLACEMENT_HPP
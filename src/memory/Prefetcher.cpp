@@ -0,0 +1,99 @@
+#include "Prefetcher.hpp"
+#include <algorithm>
+#include <cctype>
+
+// Confiança mínima para que o stride prefetcher comece a emitir prefetches
+static constexpr int STRIDE_CONFIDENCE_THRESHOLD = 2;
+static constexpr int STRIDE_CONFIDENCE_MAX = 3;
+
+std::unique_ptr<Prefetcher> Prefetcher::create(PrefetchPolicy policy, size_t line_size, size_t degree) {
+    if (degree == 0) degree = 1;
+    switch (policy) {
+        case PrefetchPolicy::NextLine:
+            return std::make_unique<NextLinePrefetcher>(line_size, degree);
+        case PrefetchPolicy::Stride:
+            return std::make_unique<StridePrefetcher>(line_size, degree);
+        default:
+            return nullptr;
+    }
+}
+
+PrefetchPolicy Prefetcher::parsePolicy(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    if (lower == "next" || lower == "nextline" || lower == "next-line") return PrefetchPolicy::NextLine;
+    if (lower == "stride") return PrefetchPolicy::Stride;
+    return PrefetchPolicy::None;
+}
+
+const char* Prefetcher::policyName(PrefetchPolicy policy) {
+    switch (policy) {
+        case PrefetchPolicy::NextLine: return "next-line";
+        case PrefetchPolicy::Stride:   return "stride";
+        default:                       return "none";
+    }
+}
+
+// ============= Next-line =============
+
+NextLinePrefetcher::NextLinePrefetcher(size_t line_size, size_t degree)
+    : line_size(line_size), degree(degree) {}
+
+void NextLinePrefetcher::observe(uint32_t pc, size_t address, bool trigger,
+                                 std::vector<size_t>& candidates) {
+    (void)pc;
+    if (!trigger) return;
+
+    size_t line = address - (address % line_size);
+    for (size_t k = 1; k <= degree; ++k) {
+        candidates.push_back(line + k * line_size);
+    }
+}
+
+// ============= Stride (RPT) =============
+
+StridePrefetcher::StridePrefetcher(size_t line_size, size_t degree, size_t table_entries)
+    : line_size(line_size), degree(degree), table(table_entries) {}
+
+void StridePrefetcher::reset() {
+    std::fill(table.begin(), table.end(), Entry{});
+}
+
+void StridePrefetcher::observe(uint32_t pc, size_t address, bool trigger,
+                               std::vector<size_t>& candidates) {
+    (void)trigger;
+    // PCs avançam de 4 em 4: descarta os 2 bits menos significativos no índice
+    Entry& e = table[(pc >> 2) % table.size()];
+
+    if (!e.valid || e.pc != pc) {
+        e = Entry{};
+        e.pc = pc;
+        e.last_address = address;
+        e.valid = true;
+        return;
+    }
+
+    const int64_t stride = static_cast<int64_t>(address) - static_cast<int64_t>(e.last_address);
+    if (stride != 0 && stride == e.stride) {
+        e.confidence = std::min(e.confidence + 1, STRIDE_CONFIDENCE_MAX);
+    } else {
+        e.confidence = std::max(e.confidence - 1, 0);
+        if (e.confidence == 0) e.stride = stride;
+    }
+    e.last_address = address;
+
+    if (e.confidence < STRIDE_CONFIDENCE_THRESHOLD || e.stride == 0) return;
+
+    const size_t current_line = address - (address % line_size);
+    size_t last_line = current_line;
+    for (size_t k = 1; k <= degree; ++k) {
+        const int64_t target = static_cast<int64_t>(address) + e.stride * static_cast<int64_t>(k);
+        if (target < 0) break;
+        const size_t line = static_cast<size_t>(target) - (static_cast<size_t>(target) % line_size);
+        // Passos menores que uma linha geram o mesmo endereço de linha várias vezes
+        if (line == current_line || line == last_line) continue;
+        candidates.push_back(line);
+        last_line = line;
+    }
+}
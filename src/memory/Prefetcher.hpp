@@ -0,0 +1,78 @@
+#ifndef PREFETCHER_HPP
+#define PREFETCHER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class PrefetchPolicy {
+    None,      // Sem prefetch
+    NextLine,  // Busca as próximas linhas sequenciais
+    Stride     // Detecta passo constante por PC (tabela RPT)
+};
+
+/**
+ * Prefetcher - Interface plugável de prefetch para a cache L1
+ *
+ * A cache informa cada acesso de demanda (PC, endereço, se foi miss ou primeiro
+ * uso de uma linha trazida por prefetch) e o prefetcher devolve os endereços das
+ * linhas que devem ser buscadas antecipadamente.
+ */
+class Prefetcher {
+public:
+    virtual ~Prefetcher() = default;
+
+    // Observa um acesso de demanda e acrescenta em `candidates` os endereços a buscar
+    virtual void observe(uint32_t pc, size_t address, bool trigger,
+                         std::vector<size_t>& candidates) = 0;
+    virtual void reset() {}
+    virtual const char* name() const = 0;
+
+    static std::unique_ptr<Prefetcher> create(PrefetchPolicy policy, size_t line_size, size_t degree);
+    static PrefetchPolicy parsePolicy(const std::string& name);
+    static const char* policyName(PrefetchPolicy policy);
+};
+
+/**
+ * NextLinePrefetcher - Prefetch sequencial "tagged"
+ * Dispara em um miss ou no primeiro uso de uma linha pré-buscada.
+ */
+class NextLinePrefetcher : public Prefetcher {
+public:
+    NextLinePrefetcher(size_t line_size, size_t degree);
+    void observe(uint32_t pc, size_t address, bool trigger, std::vector<size_t>& candidates) override;
+    const char* name() const override { return "next-line"; }
+
+private:
+    size_t line_size;
+    size_t degree;
+};
+
+/**
+ * StridePrefetcher - Reference Prediction Table indexada pelo PC
+ * Cada entrada guarda o último endereço, o passo e um contador de confiança.
+ */
+class StridePrefetcher : public Prefetcher {
+public:
+    StridePrefetcher(size_t line_size, size_t degree, size_t table_entries = 64);
+    void observe(uint32_t pc, size_t address, bool trigger, std::vector<size_t>& candidates) override;
+    void reset() override;
+    const char* name() const override { return "stride"; }
+
+private:
+    struct Entry {
+        uint32_t pc = 0;
+        size_t last_address = 0;
+        int64_t stride = 0;
+        int confidence = 0;
+        bool valid = false;
+    };
+
+    size_t line_size;
+    size_t degree;
+    std::vector<Entry> table;
+};
+
+#endif // PREFETCHER_HPP
@@ -0,0 +1,97 @@
+#include "ReuseProfiler.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr size_t INITIAL_POSITIONS = 4096;
+
+// Mistura os bits da linha (finalizador do MurmurHash3) para amostrar sem viés de endereço
+uint32_t hashLine(uint32_t line) {
+    line ^= line >> 16;
+    line *= 0x85ebca6bu;
+    line ^= line >> 13;
+    line *= 0xc2b2ae35u;
+    line ^= line >> 16;
+    return line;
+}
+
+// Faixa da distância: 0 para 0, senão o número de bits (d < 2^k cai nas faixas 0..k)
+size_t bucketOf(uint64_t distance) {
+    size_t bucket = 0;
+    while (distance > 0 && bucket < REUSE_BUCKETS - 1) {
+        distance >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+} // namespace
+
+ReuseProfiler::ReuseProfiler(uint32_t sample_period, size_t line_size)
+    : period(std::max<uint32_t>(1, sample_period)),
+      line_size(std::max<size_t>(1, line_size)),
+      histogram(REUSE_BUCKETS, 0),
+      marks(INITIAL_POSITIONS) {}
+
+void ReuseProfiler::access(uint32_t address) {
+    ++total;
+    const uint32_t line = static_cast<uint32_t>(address / line_size);
+    if (period > 1 && hashLine(line) % period != 0) return;
+
+    ++sampled_accesses;
+    if (now == marks.size()) compact();
+
+    auto it = last.find(line);
+    if (it != last.end()) {
+        const uint64_t distance = static_cast<uint64_t>(marks.prefix(now) - marks.prefix(it->second + 1));
+        ++histogram[bucketOf(distance * period)];
+        marks.add(it->second, -1);
+        it->second = now;
+    } else {
+        ++cold;
+        last.emplace(line, now);
+    }
+    marks.add(now, 1);
+    ++now;
+}
+
+void ReuseProfiler::compact() {
+    std::vector<std::pair<size_t, uint32_t>> order;
+    order.reserve(last.size());
+    for (const auto& [line, position] : last) order.emplace_back(position, line);
+    std::sort(order.begin(), order.end());
+
+    marks = FenwickTree(std::max(INITIAL_POSITIONS, 2 * order.size()));
+    for (size_t i = 0; i < order.size(); ++i) {
+        last[order[i].second] = i;
+        marks.add(i, 1);
+    }
+    now = order.size();
+}
+
+double ReuseProfiler::missRatio(size_t lines) const {
+    if (sampled_accesses == 0) return 0.0;
+    if (lines == 0) return 1.0;
+    // Acertam os reusos com distância < lines; sem potência de 2 arredonda para baixo
+    const size_t limit = bucketOf(lines) - 1;
+    uint64_t hits = 0;
+    for (size_t bucket = 0; bucket <= limit; ++bucket) hits += histogram[bucket];
+    return static_cast<double>(sampled_accesses - hits) / sampled_accesses;
+}
+
+MissRatioCurve ReuseProfiler::curve() const {
+    MissRatioCurve result;
+    result.accesses = total;
+    result.sampled = sampled_accesses;
+    if (sampled_accesses == 0) return result;
+
+    size_t highest = 0;
+    for (size_t bucket = 0; bucket < REUSE_BUCKETS; ++bucket) {
+        if (histogram[bucket] > 0) highest = bucket;
+    }
+    for (size_t bucket = 0; bucket <= highest; ++bucket) {
+        const size_t lines = size_t(1) << bucket;
+        result.points.push_back(MissRatioPoint{lines, missRatio(lines)});
+    }
+    return result;
+}
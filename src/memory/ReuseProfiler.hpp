@@ -0,0 +1,95 @@
+#ifndef REUSE_PROFILER_HPP
+#define REUSE_PROFILER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define REUSE_DEFAULT_SAMPLE 8   // Período de amostragem padrão (1 de cada 8 linhas)
+#define REUSE_BUCKETS 33         // Distâncias agrupadas por potência de 2 (0, 1, 2-3, 4-7, ...)
+
+/**
+ * Árvore de Fenwick sobre posições de um fluxo de acessos (somas de prefixo em O(log n))
+ */
+class FenwickTree {
+public:
+    explicit FenwickTree(size_t size = 0) : tree(size + 1, 0) {}
+
+    size_t size() const { return tree.size() - 1; }
+
+    void add(size_t index, int delta) {
+        for (size_t i = index + 1; i < tree.size(); i += i & (~i + 1)) tree[i] += delta;
+    }
+    // Soma das posições [0, index)
+    int64_t prefix(size_t index) const {
+        int64_t sum = 0;
+        for (size_t i = index; i > 0; i -= i & (~i + 1)) sum += tree[i];
+        return sum;
+    }
+
+private:
+    std::vector<int64_t> tree;
+};
+
+/**
+ * Um ponto da curva de miss: LRU totalmente associativa de `lines` linhas
+ */
+struct MissRatioPoint {
+    size_t lines;
+    double miss_ratio;
+};
+
+struct MissRatioCurve {
+    int pid = 0;
+    std::string name;
+    uint64_t accesses = 0;   // Acessos observados (antes da amostragem)
+    uint64_t sampled = 0;    // Acessos às linhas amostradas
+    std::vector<MissRatioPoint> points;
+};
+
+/**
+ * ReuseProfiler - Distância de reuso (pilha LRU) online de um processo
+ *
+ * Amostragem espacial por hash da linha (como o SHARDS): só 1 de cada
+ * `sample_period` linhas entra no perfil, sempre as mesmas, então as distâncias
+ * medidas entre as linhas amostradas valem `sample_period` vezes mais no fluxo
+ * completo. Entre as amostradas a distância é exata: a Fenwick marca o último
+ * acesso de cada linha e conta as linhas distintas usadas desde então.
+ *
+ * Sem locks: só o núcleo que executa o processo chama access().
+ */
+class ReuseProfiler {
+public:
+    ReuseProfiler(uint32_t sample_period, size_t line_size);
+
+    void access(uint32_t address);
+
+    uint64_t accesses() const { return total; }
+    uint64_t sampled() const { return sampled_accesses; }
+    uint64_t coldMisses() const { return cold; }
+    uint32_t samplePeriod() const { return period; }
+
+    // Fração de misses de uma LRU totalmente associativa com `lines` linhas (potência de 2)
+    double missRatio(size_t lines) const;
+    // Tamanhos de 1 linha até a maior distância observada, dobrando a cada ponto
+    MissRatioCurve curve() const;
+
+private:
+    uint32_t period;
+    size_t line_size;
+    uint64_t total = 0;
+    uint64_t sampled_accesses = 0;
+    uint64_t cold = 0;
+    std::vector<uint64_t> histogram;   // Reusos por faixa de distância (já escalada)
+
+    FenwickTree marks;
+    std::unordered_map<uint32_t, size_t> last;   // Linha -> posição do último acesso
+    size_t now = 0;
+
+    // Renumera os últimos acessos para 0..n-1 quando as posições acabam
+    void compact();
+};
+
+#endif // REUSE_PROFILER_HPP
@@ -4,9 +4,11 @@
 #include <cstdint>
 #include <vector>
 #include <cstddef>
+#include <string>
+#include "SparseMemory.hpp"
 
 #define MEMORY_ACCESS_ERROR UINT32_MAX
-#define MAX_SECONDARY_MEMORY_SIZE 8192
+#define DEFAULT_SECONDARY_MEMORY_SIZE (1u << 22)  // 4 Mi palavras (16 MiB)
 
 using std::size_t;
 using std::uint32_t;
@@ -15,19 +17,23 @@ using std::vector;
 class SECONDARY_MEMORY {
 private:
     size_t size;
-    vector<uint32_t> storage; // Alterado para um vetor simples
+    SparseMemory storage; // Páginas alocadas sob demanda (heap ou arquivo mapeado)
 
     bool notFull();
     bool isEmpty();
 
 public:
-    SECONDARY_MEMORY(size_t size);
+    // Com `backingFile`, o disco é um arquivo esparso mapeado que persiste entre execuções
+    SECONDARY_MEMORY(size_t size, const std::string& backingFile = "");
     ~SECONDARY_MEMORY();
     uint32_t ReadMem(uint32_t address);
     uint32_t WriteMem(uint32_t address, uint32_t data);
     uint32_t DeleteData(uint32_t address);
 
-    const std::vector<uint32_t>& getStorage() const { return storage; }
+    size_t getSize() const { return size; }
+    size_t getUsed() const { return storage.usedWords(); }
+    bool isFileBacked() const { return storage.getBacking() == SparseBacking::File; }
+    const SparseMemory& getStorage() const { return storage; }
 };
 
 #endif
\ No newline at end of file
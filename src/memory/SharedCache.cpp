@@ -0,0 +1,184 @@
+#include "SharedCache.hpp"
+#include <algorithm>
+
+SharedCache::SharedCache(const SharedCacheConfig& cfg)
+    : config(cfg) {
+    if (config.line_size == 0) config.line_size = 1;
+    ways = std::clamp<size_t>(config.ways, 1, L2_MAX_WAYS);
+    num_sets = std::max<size_t>(1, config.lines / ways);
+    config.ways = ways;
+    config.lines = num_sets * ways;
+    full_mask = ways == 32 ? 0xFFFFFFFFu : (1u << ways) - 1;
+
+    entries.assign(config.lines, Entry{});
+    stripes = std::make_unique<Stripe[]>(L2_LOCK_STRIPES);
+    for (int clos = 0; clos < L2_MAX_CLASSES; ++clos) {
+        masks[clos] = full_mask;
+        class_accesses[clos] = 0;
+        class_misses[clos] = 0;
+        epoch_accesses[clos] = 0;
+    }
+
+    monitor_stride = std::max<size_t>(1, num_sets / L2_MONITOR_SETS);
+    if (config.rebalance_interval > 0) {
+        const size_t monitored = (num_sets + monitor_stride - 1) / monitor_stride;
+        monitors.assign(L2_MAX_CLASSES * monitored, {});
+        way_hits = std::vector<std::atomic<uint64_t>>(L2_MAX_CLASSES * ways);
+    }
+}
+
+bool SharedCache::access(uint32_t address, int clos) {
+    clos = std::clamp(clos, 0, L2_MAX_CLASSES - 1);
+    const uint32_t base = address - static_cast<uint32_t>(address % config.line_size);
+    const size_t set = setOf(base);
+    class_accesses[clos].fetch_add(1, std::memory_order_relaxed);
+
+    bool hit = false;
+    {
+        std::lock_guard<std::mutex> lock(stripes[set % L2_LOCK_STRIPES].mutex);
+        Entry* first = &entries[set * ways];
+        const uint64_t now = tick.fetch_add(1, std::memory_order_relaxed) + 1;
+        for (size_t way = 0; way < ways; ++way) {
+            if (first[way].valid && first[way].tag == base) {
+                first[way].last_used = now;
+                hit = true;
+                break;
+            }
+        }
+        if (!hit) {
+            // Vítima só entre as vias da máscara: inválida primeiro, senão a LRU
+            uint32_t mask = masks[clos].load(std::memory_order_relaxed) & full_mask;
+            if (mask == 0) mask = full_mask;
+            Entry* victim = nullptr;
+            for (size_t way = 0; way < ways; ++way) {
+                if (!(mask & (1u << way))) continue;
+                Entry& entry = first[way];
+                if (!entry.valid) {
+                    victim = &entry;
+                    break;
+                }
+                if (!victim || entry.last_used < victim->last_used) victim = &entry;
+            }
+            victim->valid = true;
+            victim->tag = base;
+            victim->clos = static_cast<uint8_t>(clos);
+            victim->last_used = now;
+        }
+        if (config.rebalance_interval > 0 && set % monitor_stride == 0) monitor(set, base, clos);
+    }
+    if (!hit) class_misses[clos].fetch_add(1, std::memory_order_relaxed);
+
+    if (config.rebalance_interval > 0) {
+        epoch_accesses[clos].fetch_add(1, std::memory_order_relaxed);
+        if (since_rebalance.fetch_add(1) + 1 >= config.rebalance_interval) rebalance();
+    }
+    return hit;
+}
+
+// Chamar com a trava do conjunto: a pilha do monitor é do conjunto
+void SharedCache::monitor(size_t set, uint32_t base, int clos) {
+    const size_t monitored = monitors.size() / L2_MAX_CLASSES;
+    std::vector<uint32_t>& stack = monitors[clos * monitored + set / monitor_stride];
+    auto it = std::find(stack.begin(), stack.end(), base);
+    if (it != stack.end()) {
+        way_hits[clos * ways + static_cast<size_t>(it - stack.begin())].fetch_add(1, std::memory_order_relaxed);
+        stack.erase(it);
+    } else if (stack.size() == ways) {
+        stack.pop_back();
+    }
+    stack.insert(stack.begin(), base);
+}
+
+void SharedCache::rebalance() {
+    std::unique_lock<std::mutex> lock(rebalance_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) return;   // Outro núcleo já está repartindo
+    since_rebalance = 0;
+
+    std::vector<int> active;
+    for (int clos = 0; clos < L2_MAX_CLASSES; ++clos) {
+        if (epoch_accesses[clos].exchange(0) > 0) active.push_back(clos);
+    }
+    if (active.size() < 2 || active.size() > ways) return;
+
+    // Hits que a classe teria com `w` vias (soma das posições da pilha < w)
+    auto hitsWith = [this](int clos, size_t w) {
+        uint64_t hits = 0;
+        for (size_t p = 0; p < w; ++p) hits += way_hits[clos * ways + p].load(std::memory_order_relaxed);
+        return hits;
+    };
+
+    // Lookahead: cada classe começa com 1 via; a sobra vai, em passos, para quem tem
+    // a maior utilidade marginal por via (o passo pode ser de várias vias)
+    std::vector<size_t> alloc(active.size(), 1);
+    size_t balance = ways - active.size();
+    while (balance > 0) {
+        size_t best = 0;
+        size_t best_step = 1;
+        double best_utility = -1.0;
+        for (size_t i = 0; i < active.size(); ++i) {
+            const uint64_t base_hits = hitsWith(active[i], alloc[i]);
+            for (size_t step = 1; step <= balance; ++step) {
+                const double utility = static_cast<double>(hitsWith(active[i], alloc[i] + step) - base_hits) / step;
+                if (utility > best_utility) {
+                    best_utility = utility;
+                    best = i;
+                    best_step = step;
+                }
+            }
+        }
+        alloc[best] += best_step;
+        balance -= best_step;
+    }
+
+    // Máscaras contíguas na ordem das classes
+    size_t next_way = 0;
+    for (size_t i = 0; i < active.size(); ++i) {
+        const uint32_t bits = alloc[i] == 32 ? 0xFFFFFFFFu : (1u << alloc[i]) - 1;
+        masks[active[i]] = bits << next_way;
+        next_way += alloc[i];
+    }
+    // Envelhece os monitores: o histórico recente pesa mais na próxima repartição
+    for (auto& hits : way_hits) hits.store(hits.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+    rebalance_count.fetch_add(1);
+}
+
+void SharedCache::invalidateRange(uint32_t base, size_t size) {
+    const size_t first = base - base % config.line_size;
+    for (size_t line = first; line < size_t(base) + size; line += config.line_size) {
+        const size_t set = setOf(static_cast<uint32_t>(line));
+        std::lock_guard<std::mutex> lock(stripes[set % L2_LOCK_STRIPES].mutex);
+        Entry* entry = &entries[set * ways];
+        for (size_t way = 0; way < ways; ++way) {
+            if (entry[way].valid && entry[way].tag == line) entry[way].valid = false;
+        }
+    }
+}
+
+void SharedCache::setMask(int clos, uint32_t mask) {
+    if (clos < 0 || clos >= L2_MAX_CLASSES) return;
+    mask &= full_mask;
+    masks[clos] = mask != 0 ? mask : full_mask;
+}
+
+uint32_t SharedCache::getMask(int clos) const {
+    if (clos < 0 || clos >= L2_MAX_CLASSES) return full_mask;
+    return masks[clos].load();
+}
+
+std::vector<SharedCacheClassStats> SharedCache::classStats() const {
+    std::vector<SharedCacheClassStats> result;
+    for (int clos = 0; clos < L2_MAX_CLASSES; ++clos) {
+        const uint64_t accesses = class_accesses[clos].load();
+        if (accesses == 0) continue;
+        SharedCacheClassStats stats;
+        stats.clos = clos;
+        stats.mask = masks[clos].load();
+        stats.accesses = accesses;
+        stats.misses = class_misses[clos].load();
+        for (const Entry& entry : entries) {
+            if (entry.valid && entry.clos == clos) ++stats.occupancy;
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
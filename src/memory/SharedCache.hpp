@@ -0,0 +1,112 @@
+#ifndef SHARED_CACHE_HPP
+#define SHARED_CACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "StripedLock.hpp"
+
+#define L2_MAX_CLASSES 16      // Classes de serviço (CLOS), como no Intel CAT
+#define L2_MAX_WAYS 32         // Máscaras de vias em 32 bits
+#define L2_LOCK_STRIPES 64     // Travas dos conjuntos (conjunto % L2_LOCK_STRIPES)
+#define L2_MONITOR_SETS 32     // Conjuntos amostrados pelos monitores de utilidade
+
+/**
+ * Configuração da L2 compartilhada por todos os núcleos
+ */
+struct SharedCacheConfig {
+    size_t lines = 0;               // 0 = sem L2 (miss da L1 vai direto para a RAM)
+    size_t ways = 8;
+    size_t line_size = 16;          // Endereços por linha (igual ao da L1)
+    uint64_t latency = 3;           // Ciclos de um hit
+    uint64_t rebalance_interval = 0; // Acessos entre repartições por utilidade (0 = máscaras fixas)
+
+    bool enabled() const { return lines > 0; }
+};
+
+/**
+ * Acessos de uma classe de serviço na L2
+ */
+struct SharedCacheClassStats {
+    int clos = 0;
+    uint32_t mask = 0;
+    uint64_t accesses = 0;
+    uint64_t misses = 0;
+    size_t occupancy = 0;   // Linhas da classe na L2 agora
+};
+
+/**
+ * SharedCache - L2 compartilhada, particionada por vias (estilo Intel CAT)
+ *
+ * Modelo de tempo: guarda só as tags. A RAM continua sendo a fonte dos dados, então
+ * a L2 apenas decide se o miss da L1 custa `latency` ou o acesso à memória.
+ *
+ * Cada processo pertence a uma classe de serviço (CLOS) com uma máscara de vias:
+ * hits valem em qualquer via, mas a linha trazida por um miss só entra nas vias da
+ * máscara. Com `rebalance_interval` as máscaras das classes ativas são refeitas
+ * periodicamente pelo algoritmo lookahead do UCP (Qureshi & Patt), a partir de
+ * monitores de utilidade com diretório de tags LRU próprio por classe em alguns
+ * conjuntos amostrados.
+ */
+class SharedCache {
+public:
+    explicit SharedCache(const SharedCacheConfig& cfg);
+
+    // true em hit; no miss a linha entra em uma via permitida para `clos`
+    bool access(uint32_t address, int clos);
+    // Descarta as linhas em [base, base + size) (quadro reaproveitado)
+    void invalidateRange(uint32_t base, size_t size);
+
+    void setMask(int clos, uint32_t mask);
+    uint32_t getMask(int clos) const;
+    uint32_t fullMask() const { return full_mask; }
+
+    const SharedCacheConfig& getConfig() const { return config; }
+    uint64_t rebalances() const { return rebalance_count.load(); }
+    // Classes que já acessaram a L2
+    std::vector<SharedCacheClassStats> classStats() const;
+
+private:
+    struct Entry {
+        bool valid = false;
+        uint32_t tag = 0;       // Endereço base da linha
+        uint8_t clos = 0;       // Classe que trouxe a linha
+        uint64_t last_used = 0;
+    };
+    struct alignas(HOST_CACHE_LINE_BYTES) Stripe {
+        std::mutex mutex;
+    };
+
+    SharedCacheConfig config;
+    size_t ways;
+    size_t num_sets;
+    uint32_t full_mask;
+    std::vector<Entry> entries;   // num_sets * ways, agrupadas por conjunto
+    std::unique_ptr<Stripe[]> stripes;
+    std::atomic<uint64_t> tick{0};
+
+    std::array<std::atomic<uint32_t>, L2_MAX_CLASSES> masks;
+    std::array<std::atomic<uint64_t>, L2_MAX_CLASSES> class_accesses;
+    std::array<std::atomic<uint64_t>, L2_MAX_CLASSES> class_misses;
+
+    // Monitores de utilidade: pilha LRU de tags por classe em cada conjunto amostrado;
+    // way_hits[clos][p] conta hits na posição p (hits com p + 1 vias)
+    size_t monitor_stride;
+    std::vector<std::vector<uint32_t>> monitors;   // [clos * monitored + i]: tags, MRU primeiro
+    std::vector<std::atomic<uint64_t>> way_hits;   // [clos * ways + posição]
+    std::array<std::atomic<uint64_t>, L2_MAX_CLASSES> epoch_accesses;
+    std::atomic<uint64_t> since_rebalance{0};
+    std::atomic<uint64_t> rebalance_count{0};
+    std::mutex rebalance_mutex;
+
+    size_t setOf(uint32_t base) const { return (base / config.line_size) % num_sets; }
+    void monitor(size_t set, uint32_t base, int clos);
+    void rebalance();
+};
+
+#endif // SHARED_CACHE_HPP
@@ -0,0 +1,126 @@
+#include "SparseMemory.hpp"
+#include <algorithm>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SparseMemory::SparseMemory(size_t words, SparseBacking backing, const std::string& path)
+    : words(words), backing(backing) {
+    const size_t page_count = (words + SPARSE_PAGE_WORDS - 1) / SPARSE_PAGE_WORDS;
+    touched.assign(page_count, 0);
+
+    if (backing != SparseBacking::Heap && page_count > 0) {
+        region_bytes = page_count * SPARSE_PAGE_WORDS * sizeof(uint32_t);
+        void* addr = mapRegion(path);
+        if (addr == MAP_FAILED) {
+            std::cerr << "[SparseMemory] mmap de " << region_bytes
+                      << " bytes falhou, usando páginas no heap\n";
+            region_bytes = 0;
+            this->backing = SparseBacking::Heap;
+        } else {
+            region = static_cast<uint32_t*>(addr);
+        }
+    }
+
+    if (!region) {
+        pages.resize(page_count);
+    }
+
+    // Só um arquivo reaproveitado começa com dados: conta-os uma vez aqui
+    if (this->backing == SparseBacking::File) {
+        used = scanUsed();
+    }
+}
+
+SparseMemory::~SparseMemory() {
+    if (region) {
+        munmap(region, region_bytes);
+    }
+}
+
+void* SparseMemory::mapRegion(const std::string& path) {
+    if (backing == SparseBacking::Mmap) {
+        return mmap(nullptr, region_bytes, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    }
+
+    // File: o arquivo só cresce (ftruncate cria buracos, que leem como zero)
+    int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return MAP_FAILED;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        (static_cast<size_t>(st.st_size) < region_bytes && ftruncate(fd, region_bytes) != 0)) {
+        close(fd);
+        return MAP_FAILED;
+    }
+
+    void* addr = mmap(nullptr, region_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr != MAP_FAILED) {
+        markFilePages(fd, std::min(static_cast<size_t>(st.st_size), region_bytes));
+    }
+    close(fd); // O mapeamento continua válido após fechar o descritor
+    return addr;
+}
+
+// Páginas com dados de execuções anteriores contam como tocadas
+void SparseMemory::markFilePages(int fd, size_t file_bytes) {
+    const size_t page_bytes = SPARSE_PAGE_WORDS * sizeof(uint32_t);
+    off_t offset = 0;
+    while (static_cast<size_t>(offset) < file_bytes) {
+        off_t data = lseek(fd, offset, SEEK_DATA);
+        if (data < 0 || static_cast<size_t>(data) >= file_bytes) break;
+        off_t hole = lseek(fd, data, SEEK_HOLE);
+        if (hole < 0) hole = static_cast<off_t>(file_bytes);
+
+        const size_t last = std::min(static_cast<size_t>(hole), file_bytes);
+        for (size_t page = data / page_bytes; page * page_bytes < last && page < touched.size(); ++page) {
+            if (!touched[page]) {
+                touched[page] = 1;
+                ++resident;
+            }
+        }
+        offset = hole;
+    }
+}
+
+uint32_t* SparseMemory::touchPage(size_t page) {
+    if (!touched[page]) {
+        // Página nova vem zerada, ou seja, toda "vazia" (~0 == MEMORY_ACCESS_ERROR)
+        if (!region) pages[page].reset(new uint32_t[SPARSE_PAGE_WORDS]());
+        touched[page] = 1;
+        ++resident;
+    }
+    return region ? region + page * SPARSE_PAGE_WORDS : pages[page].get();
+}
+
+bool SparseMemory::write(size_t address, uint32_t value) {
+    if (address >= words) return false;
+    const size_t page = address / SPARSE_PAGE_WORDS;
+    // Apagar um endereço de página nunca tocada não precisa alocá-la
+    if (value == MEMORY_ACCESS_ERROR && !touched[page]) return true;
+    uint32_t& slot = touchPage(page)[address % SPARSE_PAGE_WORDS];
+    const bool was_used = (slot != 0);
+    const bool now_used = (value != MEMORY_ACCESS_ERROR);
+    if (was_used != now_used) {
+        if (now_used) used.fetch_add(1, std::memory_order_relaxed);
+        else used.fetch_sub(1, std::memory_order_relaxed);
+    }
+    slot = ~value;
+    return true;
+}
+
+size_t SparseMemory::scanUsed() const {
+    size_t used = 0;
+    for (size_t page = 0; page < touched.size(); ++page) {
+        const uint32_t* data = pageData(page);
+        if (!data) continue;
+        const size_t limit = std::min<size_t>(SPARSE_PAGE_WORDS, words - page * SPARSE_PAGE_WORDS);
+        for (size_t i = 0; i < limit; ++i) {
+            if (data[i] != 0) ++used;
+        }
+    }
+    return used;
+}
@@ -0,0 +1,76 @@
+#ifndef SPARSE_MEMORY_HPP
+#define SPARSE_MEMORY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define MEMORY_ACCESS_ERROR UINT32_MAX
+#define SPARSE_PAGE_WORDS 1024  // Palavras por página física (4 KiB)
+
+enum class SparseBacking {
+    Heap,   // Páginas alocadas no heap no primeiro write
+    Mmap,   // Região anônima reservada com MAP_NORESERVE (o SO aloca no primeiro toque)
+    File    // Arquivo esparso mapeado com MAP_SHARED (persiste entre execuções)
+};
+
+/**
+ * SparseMemory - Armazenamento de palavras por páginas, alocado sob demanda
+ *
+ * Endereços nunca escritos leem MEMORY_ACCESS_ERROR sem ocupar memória do host,
+ * o que permite capacidades na casa dos GiB. As palavras são guardadas
+ * complementadas (~valor): uma página zerada (nova no heap, no mmap ou um
+ * buraco do arquivo) já representa "vazio" sem precisar ser preenchida.
+ * Acessos a páginas diferentes podem ocorrer em paralelo; o chamador serializa
+ * os acessos a uma mesma página (travas por página do MemoryManager).
+ */
+class SparseMemory {
+public:
+    SparseMemory(size_t words, SparseBacking backing = SparseBacking::Heap,
+                 const std::string& path = "");
+    ~SparseMemory();
+
+    SparseMemory(const SparseMemory&) = delete;
+    SparseMemory& operator=(const SparseMemory&) = delete;
+
+    size_t size() const { return words; }
+    SparseBacking getBacking() const { return backing; }
+    size_t residentPages() const { return resident.load(std::memory_order_relaxed); }
+
+    // Endereços com dado válido (contador mantido a cada write, O(1))
+    size_t usedWords() const { return used.load(std::memory_order_relaxed); }
+
+    uint32_t read(size_t address) const {
+        if (address >= words) return MEMORY_ACCESS_ERROR;
+        const uint32_t* page = pageData(address / SPARSE_PAGE_WORDS);
+        return page ? ~page[address % SPARSE_PAGE_WORDS] : MEMORY_ACCESS_ERROR;
+    }
+
+    // Retorna false se o endereço estiver fora da capacidade.
+    // Atualiza o contador de ocupação quando a palavra passa de vazia a válida ou vice-versa
+    bool write(size_t address, uint32_t value);
+
+private:
+    size_t words;
+    SparseBacking backing;
+    uint32_t* region = nullptr;                      // Mmap/File: região contínua mapeada
+    size_t region_bytes = 0;
+    std::vector<std::unique_ptr<uint32_t[]>> pages;  // Heap: diretório de páginas
+    std::vector<uint8_t> touched;                    // Página já recebeu algum write
+    std::atomic<size_t> resident{0};                 // Páginas tocadas (várias travas incrementam)
+    std::atomic<size_t> used{0};                     // Palavras com dado válido
+
+    const uint32_t* pageData(size_t page) const {
+        if (!touched[page]) return nullptr;
+        return region ? region + page * SPARSE_PAGE_WORDS : pages[page].get();
+    }
+    uint32_t* touchPage(size_t page);
+    void* mapRegion(const std::string& path);
+    void markFilePages(int fd, size_t file_bytes);
+    size_t scanUsed() const;
+};
+
+#endif
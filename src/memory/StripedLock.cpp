@@ -0,0 +1,36 @@
+#include "StripedLock.hpp"
+#include <chrono>
+
+uint64_t StripedLock::maskFor(size_t first_page, size_t last_page) {
+    if (last_page - first_page + 1 >= LOCK_STRIPES) return ~uint64_t(0);
+    uint64_t mask = 0;
+    for (size_t page = first_page; page <= last_page; ++page) {
+        mask |= uint64_t(1) << (page % LOCK_STRIPES);
+    }
+    return mask;
+}
+
+LockWait StripedLock::lock(uint64_t mask, bool exclusive) {
+    LockWait wait;
+    for (size_t i = 0; i < LOCK_STRIPES; ++i) {
+        if (!(mask & (uint64_t(1) << i))) continue;
+        std::shared_mutex& mutex = stripes[i].mutex;
+        if (exclusive ? mutex.try_lock() : mutex.try_lock_shared()) continue;
+
+        const auto start = std::chrono::steady_clock::now();
+        if (exclusive) mutex.lock();
+        else mutex.lock_shared();
+        const auto waited = std::chrono::steady_clock::now() - start;
+        ++wait.contentions;
+        wait.wait_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count();
+    }
+    return wait;
+}
+
+void StripedLock::unlock(uint64_t mask, bool exclusive) {
+    for (size_t i = LOCK_STRIPES; i-- > 0;) {
+        if (!(mask & (uint64_t(1) << i))) continue;
+        if (exclusive) stripes[i].mutex.unlock();
+        else stripes[i].mutex.unlock_shared();
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef STRIPED_LOCK_HPP
+#define STRIPED_LOCK_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <shared_mutex>
+
+#define LOCK_STRIPES 64          // Travas independentes (uma máscara de 64 bits cobre todas)
+#define HOST_CACHE_LINE_BYTES 64 // Linha de cache do host (evita false sharing entre travas)
+
+/**
+ * Espera observada ao adquirir um conjunto de travas
+ */
+struct LockWait {
+    uint64_t contentions = 0;  // Travas que já estavam ocupadas
+    uint64_t wait_ns = 0;      // Tempo bloqueado esperando por elas
+};
+
+/**
+ * StripedLock - Conjunto de shared_mutex indexado por página física
+ *
+ * Cada página cai na trava `página % LOCK_STRIPES`; núcleos que acessam regiões
+ * diferentes quase nunca disputam a mesma trava. Cada trava ocupa uma linha de
+ * cache do host para que núcleos em travas distintas não invalidem a linha uns
+ * dos outros. Um acesso que cobre várias páginas recebe uma máscara de travas,
+ * adquiridas sempre em ordem crescente (sem deadlock).
+ */
+class StripedLock {
+public:
+    // Máscara das travas das páginas [first_page, last_page]
+    static uint64_t maskFor(size_t first_page, size_t last_page);
+
+    // Tenta cada trava sem bloquear; só as ocupadas são cronometradas
+    LockWait lock(uint64_t mask, bool exclusive);
+    void unlock(uint64_t mask, bool exclusive);
+
+private:
+    struct alignas(HOST_CACHE_LINE_BYTES) Stripe {
+        std::shared_mutex mutex;
+    };
+
+    std::array<Stripe, LOCK_STRIPES> stripes;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "TLB.hpp"
+
+TLB::TLB(const TLBConfig& cfg) : config(cfg) {
+    if (config.entries == 0) config.entries = 1;
+    ways = (cfg.ways == 0 || cfg.ways > config.entries) ? config.entries : cfg.ways;
+    num_sets = config.entries / ways;
+    config.entries = num_sets * ways;
+    config.ways = ways;
+    entries.assign(config.entries, Entry{});
+}
+
+PageTableEntry* TLB::lookup(uint16_t asid, uint32_t vpn) {
+    const size_t first = setOf(vpn) * ways;
+    for (size_t i = first; i < first + ways; ++i) {
+        Entry& e = entries[i];
+        if (e.valid && e.asid == asid && e.vpn == vpn) {
+            if (!e.pte->present) {
+                // Página saiu da memória: tradução obsoleta
+                e.valid = false;
+                break;
+            }
+            e.last_used = ++tick;
+            ++hits;
+            return e.pte;
+        }
+    }
+    ++misses;
+    return nullptr;
+}
+
+void TLB::insert(uint16_t asid, uint32_t vpn, PageTableEntry* pte) {
+    const size_t first = setOf(vpn) * ways;
+    size_t victim = first;
+    uint64_t oldest = UINT64_MAX;
+
+    // LRU dentro do conjunto; via inválida ou com a mesma tradução tem prioridade
+    for (size_t i = first; i < first + ways; ++i) {
+        const Entry& e = entries[i];
+        if (!e.valid || (e.asid == asid && e.vpn == vpn)) {
+            victim = i;
+            break;
+        }
+        if (e.last_used < oldest) {
+            oldest = e.last_used;
+            victim = i;
+        }
+    }
+
+    Entry& e = entries[victim];
+    e.valid = true;
+    e.asid = asid;
+    e.vpn = vpn;
+    e.pte = pte;
+    e.last_used = ++tick;
+}
+
+void TLB::invalidate(uint16_t asid, uint32_t vpn) {
+    const size_t first = setOf(vpn) * ways;
+    for (size_t i = first; i < first + ways; ++i) {
+        Entry& e = entries[i];
+        if (e.valid && e.asid == asid && e.vpn == vpn) e.valid = false;
+    }
+}
+
+void TLB::flush() {
+    for (auto& e : entries) e.valid = false;
+}
@@ -0,0 +1,58 @@
+#ifndef TLB_HPP
+#define TLB_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "AddressSpace.hpp"
+
+/**
+ * Configuração da TLB de cada núcleo
+ */
+struct TLBConfig {
+    size_t entries = 64;  // Total de entradas
+    size_t ways = 4;      // Associatividade (0 = totalmente associativa)
+};
+
+/**
+ * TLB - Cache de traduções VPN -> PTE, associativa por conjunto com LRU
+ *
+ * As entradas são marcadas com o ASID do processo, então a troca de contexto
+ * não precisa esvaziar a TLB. Uma entrada cuja PTE deixou de estar presente
+ * é tratada como miss.
+ */
+class TLB {
+public:
+    explicit TLB(const TLBConfig& cfg = TLBConfig{});
+
+    // Retorna a PTE em caso de hit, ou nulo em caso de miss
+    PageTableEntry* lookup(uint16_t asid, uint32_t vpn);
+    void insert(uint16_t asid, uint32_t vpn, PageTableEntry* pte);
+    void invalidate(uint16_t asid, uint32_t vpn);
+    void flush();
+
+    const TLBConfig& getConfig() const { return config; }
+    uint64_t get_hits() const { return hits; }
+    uint64_t get_misses() const { return misses; }
+
+private:
+    struct Entry {
+        bool valid = false;
+        uint16_t asid = 0;
+        uint32_t vpn = 0;
+        PageTableEntry* pte = nullptr;
+        uint64_t last_used = 0;
+    };
+
+    TLBConfig config;
+    size_t ways;
+    size_t num_sets;
+    std::vector<Entry> entries;  // num_sets * ways, agrupadas por conjunto
+    uint64_t tick = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    size_t setOf(uint32_t vpn) const { return vpn % num_sets; }
+};
+
+#endif
@@ -3,97 +3,255 @@
 #include "MemoryManager.hpp" // Necessário para a lógica de write-back
 
 Cache::Cache() {
-    this->capacity = CACHE_CAPACITY;
-    this->cacheMap.reserve(CACHE_CAPACITY);
-    this->cache_misses = 0;
-    this->cache_hits = 0;
+    init(CacheConfig{});
 }
 
 Cache::Cache(size_t custom_capacity) {
-    this->capacity = custom_capacity;
-    this->cacheMap.reserve(custom_capacity);
+    CacheConfig cfg;
+    cfg.lines = custom_capacity;
+    init(cfg);
+}
+
+Cache::Cache(const CacheConfig& cfg) {
+    init(cfg);
+}
+
+void Cache::init(const CacheConfig& cfg) {
+    this->config = cfg;
+    if (this->config.lines == 0) this->config.lines = 1;
+    if (this->config.line_size == 0) this->config.line_size = 1;
+
+    // ways == 0 (ou maior que o total) => totalmente associativa
+    this->ways = (cfg.ways == 0 || cfg.ways > this->config.lines) ? this->config.lines : cfg.ways;
+    this->num_sets = this->config.lines / this->ways;
+    this->config.lines = this->num_sets * this->ways;
+    this->config.ways = this->ways;
+
+    this->lines.assign(this->config.lines, CacheLine{});
+    this->lineIndex.reserve(this->config.lines);
+    this->policy.setPolicy(cfg.replacement);
+    this->prefetcher = Prefetcher::create(cfg.prefetch, this->config.line_size, cfg.prefetch_degree);
+    this->tick = 0;
+    this->current_owner = 0;
     this->cache_misses = 0;
     this->cache_hits = 0;
+    this->set_stats.assign(this->num_sets, CacheSetStats{});
 }
 
 Cache::~Cache() {
-    this->cacheMap.clear();
+    this->lineIndex.clear();
+}
+
+CacheLine* Cache::find(size_t address) {
+    auto it = lineIndex.find(lineAddress(address));
+    if (it == lineIndex.end()) return nullptr;
+    CacheLine& line = lines[it->second];
+    return line.isValid ? &line : nullptr;
+}
+
+const CacheLine* Cache::peek(size_t address) const {
+    auto it = lineIndex.find(lineAddress(address));
+    if (it == lineIndex.end()) return nullptr;
+    const CacheLine& line = lines[it->second];
+    return line.isValid ? &line : nullptr;
+}
+
+bool Cache::touchShadow(size_t base) {
+    auto it = shadowIndex.find(base);
+    if (it != shadowIndex.end()) {
+        shadow.splice(shadow.begin(), shadow, it->second);
+        return true;
+    }
+    shadow.push_front(base);
+    shadowIndex[base] = shadow.begin();
+    if (shadow.size() > config.lines) {
+        shadowIndex.erase(shadow.back());
+        shadow.pop_back();
+    }
+    return false;
+}
+
+void Cache::forgetLine(size_t base) {
+    touched.erase(base);
+    auto it = shadowIndex.find(base);
+    if (it == shadowIndex.end()) return;
+    shadow.erase(it->second);
+    shadowIndex.erase(it);
+}
+
+CacheLookup Cache::lookup(size_t address, uint32_t& value) {
+    const size_t base = lineAddress(address);
+    CacheSetStats& set = set_stats[setOf(base)];
+    ++set.accesses;
+    const bool shadow_hit = touchShadow(base);
+
+    CacheLine* line = find(address);
+    if (!line) {
+        cache_misses++;
+        ++set.misses;
+        if (touched.insert(base).second) {
+            last_miss = MissClass::Compulsory;
+            ++set.compulsory;
+        } else if (!shadow_hit) {
+            last_miss = MissClass::Capacity;
+            ++set.capacity;
+        } else {
+            last_miss = MissClass::Conflict;
+            ++set.conflict;
+        }
+        return CacheLookup::Miss;
+    }
+
+    cache_hits++;
+    line->last_used = ++tick;
+    value = line->data[address - line->tag];
+
+    if (line->prefetched) {
+        // Linha trazida por prefetch: a primeira referência não passou por um miss
+        touched.insert(base);
+        line->prefetched = false;
+        return CacheLookup::PrefetchHit;
+    }
+    return CacheLookup::Hit;
+}
+
+CacheSetStats Cache::totals() const {
+    CacheSetStats total;
+    for (const CacheSetStats& set : set_stats) {
+        total.accesses += set.accesses;
+        total.misses += set.misses;
+        total.compulsory += set.compulsory;
+        total.capacity += set.capacity;
+        total.conflict += set.conflict;
+    }
+    return total;
 }
 
 size_t Cache::get(size_t address) {
-    if (cacheMap.count(address) > 0 && cacheMap[address].isValid) {
-        cache_hits++;
-        return cacheMap[address].data; // Cache hit
+    uint32_t value;
+    if (lookup(address, value) == CacheLookup::Miss) {
+        return CACHE_MISS; // Cache miss
     }
+    return value; // Cache hit
+}
 
-    cache_misses++;
-    return CACHE_MISS; // Cache miss
-}
-
-void Cache::put(size_t address, size_t data, MemoryManager* memManager) {
-    (void)memManager; // Parâmetro reservado para write-back em implementações futuras
-    
-    // Se a cache está cheia, precisamos remover um item
-    if (cacheMap.size() >= capacity) {
-        CachePolicy cachepolicy;
-        // A política de remoção nos dirá qual endereço remover
-        int addr_to_remove = cachepolicy.getAddressToReplace(fifo_queue);
-
-        if (addr_to_remove != -1) {
-            // NOTE: Write-back desabilitado na arquitetura multicore
-            // Cache L1 é privada, write-back seria feito para memória compartilhada
-            // Por simplicidade, usamos write-through (dados escritos imediatamente)
-            // Em arquitetura real, isso seria otimizado com protocolo de coerência
-            
-            // Remove da cache
-            cacheMap.erase(static_cast<size_t>(addr_to_remove));
+void Cache::put(size_t address, const std::vector<uint32_t>& data, MemoryManager* memManager, bool prefetched) {
+    const size_t base = lineAddress(address);
+    if (lineIndex.count(base) > 0) return; // Linha já presente
+
+    // A política de substituição escolhe a via dentro do conjunto
+    const size_t first = setOf(base) * ways;
+    const size_t victim = policy.selectVictim(lines, first, ways);
+    CacheLine& line = lines[victim];
+
+    if (line.isValid) {
+        // Write-back: a linha suja volta para a memória compartilhada antes de sair
+        if (line.isDirty && memManager) {
+            memManager->writeBackLine(static_cast<uint32_t>(line.tag), line.data);
         }
+        lineIndex.erase(line.tag);
     }
 
-    // Adiciona o novo item na cache
-    CacheEntry new_entry;
-    new_entry.data = data;
-    new_entry.isValid = true;
-    new_entry.isDirty = false; // Começa como "limpo"
+    line.tag = base;
+    line.owner = current_owner;
+    line.isValid = true;
+    line.isDirty = false; // Começa como "limpo"
+    line.prefetched = prefetched;
+    line.inserted_at = ++tick;
+    line.last_used = prefetched ? 0 : tick;
+    line.data = data;
+    line.data.resize(config.line_size, CACHE_MISS);
 
-    cacheMap[address] = new_entry;
-    fifo_queue.push(address); // Adiciona na fila do FIFO
+    lineIndex[base] = victim;
 }
 
 void Cache::update(size_t address, size_t data) {
-    // Se o item não está na cache, primeiro o colocamos lá
-    if (cacheMap.find(address) == cacheMap.end()) {
-        // Para a simplicidade, assumimos que o `put` deve ser chamado pelo `MemoryManager`
-        // em um cache miss de escrita. Aqui, focamos em atualizar.
-        // Em um sistema real, aqui ocorreria um "write-allocate".
-        // Por ora, vamos apenas atualizar se existir.
-        return;
-    }
-    
-    cacheMap[address].data = data;
-    cacheMap[address].isDirty = true; // Marca como sujo
-    cacheMap[address].isValid = true;
+    CacheLine* line = find(address);
+    // O `put` (write-allocate) deve ter sido chamado pelo MemoryManager no miss de escrita
+    if (!line) return;
+
+    line->data[address - line->tag] = static_cast<uint32_t>(data);
+    line->isDirty = true; // Marca como sujo
+    line->owner = current_owner;
+    line->prefetched = false;
+    line->last_used = ++tick;
 }
 
 void Cache::invalidate() {
-    for (auto &c : cacheMap) {
-        c.second.isValid = false;
+    for (auto &line : lines) {
+        line.isValid = false;
+        line.isDirty = false;
+        line.prefetched = false;
+    }
+    lineIndex.clear();
+    shadow.clear();
+    shadowIndex.clear();
+    touched.clear();
+    if (prefetcher) prefetcher->reset();
+}
+
+void Cache::invalidateRange(size_t base, size_t size, MemoryManager* memManager) {
+    for (size_t tag = lineAddress(base); tag < base + size; tag += config.line_size) forgetLine(tag);
+    for (auto &line : lines) {
+        if (!line.isValid || line.tag < base || line.tag >= base + size) continue;
+        if (line.isDirty && memManager) {
+            memManager->writeBackLine(static_cast<uint32_t>(line.tag), line.data);
+        }
+        line.isValid = false;
+        line.isDirty = false;
+        line.prefetched = false;
+        lineIndex.erase(line.tag);
+    }
+}
+
+size_t Cache::occupancy(uint32_t owner) const {
+    size_t count = 0;
+    for (const auto &line : lines) {
+        if (line.isValid && line.owner == owner) ++count;
+    }
+    return count;
+}
+
+void Cache::invalidateOwner(uint32_t owner, MemoryManager* memManager) {
+    for (auto &line : lines) {
+        if (!line.isValid || line.owner != owner) continue;
+        if (line.isDirty && memManager) {
+            memManager->writeBackLine(static_cast<uint32_t>(line.tag), line.data);
+        }
+        forgetLine(line.tag);
+        line.isValid = false;
+        line.isDirty = false;
+        line.prefetched = false;
+        lineIndex.erase(line.tag);
+    }
+}
+
+void Cache::writeBackDirty(MemoryManager* memManager) {
+    if (!memManager) return;
+    for (auto &line : lines) {
+        if (line.isValid && line.isDirty) {
+            memManager->writeBackLine(static_cast<uint32_t>(line.tag), line.data);
+            line.isDirty = false;
+        }
     }
-    // Limpar a fila FIFO também, pois a cache foi invalidada
-    std::queue<size_t> empty;
-    fifo_queue.swap(empty);
 }
 
 std::vector<std::pair<size_t, size_t>> Cache::dirtyData() {
     std::vector<std::pair<size_t, size_t>> dirty_data;
-    for (const auto &c : cacheMap) {
-        if (c.second.isDirty) {
-            dirty_data.emplace_back(c.first, c.second.data);
+    for (const auto &line : lines) {
+        if (!line.isValid || !line.isDirty) continue;
+        for (size_t i = 0; i < line.data.size(); ++i) {
+            dirty_data.emplace_back(line.tag + i, line.data[i]);
         }
     }
     return dirty_data;
 }
 
+void Cache::prefetchCandidates(uint32_t pc, size_t address, bool trigger, std::vector<size_t>& out) {
+    if (!prefetcher) return;
+    prefetcher->observe(pc, address, trigger, out);
+}
+
 int Cache::get_misses(){
        // Retorna o número de cache misses
     return cache_misses;
@@ -2,41 +2,137 @@
 #define CACHE_HPP
 
 #include <cstdint>
-#include <cstddef> 
+#include <cstddef>
+#include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
-#include <queue> // Adicionado para FIFO
+#include <memory>
+#include "cachePolicy.hpp"
+#include "Prefetcher.hpp"
 
-#define CACHE_CAPACITY 128  // Aumentado de 16 para 128 (8x maior para melhor hit rate)
+#define CACHE_CAPACITY 128  // Número de linhas (aumentado de 16 para 128)
+#define CACHE_LINE_SIZE 16  // Endereços por linha (4 palavras de 32 bits)
 #define CACHE_MISS UINT32_MAX
 
-struct CacheEntry {
-    size_t data;
-    bool isValid;
-    bool isDirty;
+/**
+ * Configuração da cache L1 (compartilhada por todos os núcleos)
+ */
+struct CacheConfig {
+    size_t lines = CACHE_CAPACITY;          // Número total de linhas
+    size_t line_size = CACHE_LINE_SIZE;     // Endereços cobertos por linha
+    size_t ways = 0;                        // 0 = totalmente associativa
+    ReplacementPolicy replacement = ReplacementPolicy::FIFO;
+    PrefetchPolicy prefetch = PrefetchPolicy::None;
+    size_t prefetch_degree = 1;             // Linhas buscadas por disparo
 };
+
+struct CacheLine {
+    size_t tag = 0;             // Endereço base da linha
+    uint32_t owner = 0;         // Processo (ASID) que trouxe ou escreveu a linha
+    bool isValid = false;
+    bool isDirty = false;
+    bool prefetched = false;    // Trazida por prefetch e ainda não usada
+    uint64_t inserted_at = 0;   // Para FIFO
+    uint64_t last_used = 0;     // Para LRU
+    std::vector<uint32_t> data; // Uma palavra por endereço da linha
+};
+
+// Resultado de uma consulta à cache
+enum class CacheLookup {
+    Miss,
+    Hit,
+    PrefetchHit   // Primeiro uso de uma linha trazida por prefetch
+};
+
+// Classificação dos misses (3C)
+enum class MissClass {
+    Compulsory,   // Primeira referência à linha nesta cache
+    Capacity,     // Também falharia numa LRU totalmente associativa do mesmo tamanho
+    Conflict      // Só falhou pelo mapeamento em conjuntos / política
+};
+
+// Acessos de demanda e misses de um conjunto (somados: totais da cache)
+struct CacheSetStats {
+    uint64_t accesses = 0;
+    uint64_t misses = 0;
+    uint64_t compulsory = 0;
+    uint64_t capacity = 0;
+    uint64_t conflict = 0;
+};
+
 class MemoryManager;
 
 class Cache {
 private:
-    std::unordered_map<size_t, CacheEntry> cacheMap;
-    std::queue<size_t> fifo_queue; // Fila para controlar a ordem de entrada (FIFO)
-    size_t capacity;
+    CacheConfig config;
+    size_t num_sets;
+    size_t ways;
+    std::vector<CacheLine> lines;                  // num_sets * ways, agrupadas por conjunto
+    std::unordered_map<size_t, size_t> lineIndex;  // endereço base -> posição em `lines`
+    CachePolicy policy;
+    std::unique_ptr<Prefetcher> prefetcher;
+    uint64_t tick;
+    uint32_t current_owner;     // Processo em execução no núcleo (tag das linhas novas)
     int cache_misses;
     int cache_hits;
 
+    // 3C: tags de uma LRU totalmente associativa com o mesmo número de linhas (sombra)
+    // e linhas já referenciadas; linhas invalidadas voltam a contar como compulsórias
+    std::list<size_t> shadow;
+    std::unordered_map<size_t, std::list<size_t>::iterator> shadowIndex;
+    std::unordered_set<size_t> touched;
+    std::vector<CacheSetStats> set_stats;
+    MissClass last_miss = MissClass::Compulsory;
+
+    void init(const CacheConfig& cfg);
+    bool touchShadow(size_t base);   // true se a sombra teria acertado
+    void forgetLine(size_t base);
+    size_t setOf(size_t line_address) const { return (line_address / config.line_size) % num_sets; }
+    CacheLine* find(size_t address);
+
 public:
     Cache();
     Cache(size_t custom_capacity);  // Construtor com tamanho customizado
+    Cache(const CacheConfig& cfg);
     ~Cache();
     int get_misses();
     int get_hits();
+
+    size_t lineSize() const { return config.line_size; }
+    size_t lineAddress(size_t address) const { return address - (address % config.line_size); }
+    const CacheConfig& getConfig() const { return config; }
+    bool contains(size_t address) const { return lineIndex.count(address - (address % config.line_size)) > 0; }
+    // Linha válida que contém `address`, sem contar acesso (nulo se ausente)
+    const CacheLine* peek(size_t address) const;
+
+    // Consulta a cache; em caso de hit devolve a palavra em `value`
+    CacheLookup lookup(size_t address, uint32_t& value);
     size_t get(size_t address);
-    // O método put agora precisa interagir com o MemoryManager para o write-back
-    void put(size_t address, size_t data, MemoryManager* memManager);
+
+    // Insere a linha que contém `address`; a vítima suja é escrita de volta via memManager
+    void put(size_t address, const std::vector<uint32_t>& line, MemoryManager* memManager, bool prefetched = false);
     void update(size_t address, size_t data);
     void invalidate();
+
+    // Tag de processo: as linhas sobrevivem à troca de contexto e são contadas por dono
+    void setOwner(uint32_t owner) { current_owner = owner; }
+    size_t occupancy(uint32_t owner) const;
+    // Descarta as linhas do processo (ele rodou em outro núcleo e elas podem estar velhas)
+    void invalidateOwner(uint32_t owner, MemoryManager* memManager);
+    // Descarta as linhas em [base, base + size); as sujas voltam antes via memManager
+    void invalidateRange(size_t base, size_t size, MemoryManager* memManager);
+    void writeBackDirty(MemoryManager* memManager);
     std::vector<std::pair<size_t, size_t>> dirtyData(); // Mantido para possíveis outras lógicas
+
+    // 3C e mapa de calor por conjunto (só acessos de demanda via lookup)
+    MissClass lastMissClass() const { return last_miss; }
+    const std::vector<CacheSetStats>& setStats() const { return set_stats; }
+    CacheSetStats totals() const;
+
+    // Prefetch: repassa o acesso de demanda ao prefetcher configurado
+    bool hasPrefetcher() const { return prefetcher != nullptr; }
+    void prefetchCandidates(uint32_t pc, size_t address, bool trigger, std::vector<size_t>& out);
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "parser_json.hpp"
 #include "../memory/MemoryManager.hpp" // Alterado de MainMemory.hpp
-#include "../cpu/PCB.hpp"              // Incluído para a função write
+#include "../cpu/PCB.hpp"              // PCB do processo carregado
 #include "../cpu/instruction_codes.hpp" // Tabela unificada de opcodes
 #include <unordered_map>
 #include <fstream>
@@ -202,8 +202,8 @@ uint32_t parseInstruction(const json &instrJson, int currentInstrIndex){
     return encodeIType(instrJson, currentInstrIndex);
 }
 
-// ======= Seções (Alteradas para usar MemoryManager) =======
-int parseData(const json &dataJson, MemoryManager &memManager, PCB& pcb, int startAddr){
+// ======= Seções: palavras da imagem, em ordem (uma a cada 4 endereços) =======
+int parseData(const json &dataJson, vector<uint32_t> &image, int startAddr){
     int addr = startAddr;
 
     if (dataJson.is_object()){
@@ -215,13 +215,13 @@ int parseData(const json &dataJson, MemoryManager &memManager, PCB& pcb, int sta
                 for (auto &e : val){
                     int w = e.is_string()? static_cast<int>(std::stoul(e.get<string>(),nullptr,0))
                                           : e.get<int>();
-                    memManager.write(addr, w, pcb); // Alterado aqui
+                    image.push_back(static_cast<uint32_t>(w));
                     addr += 4;
                 }
             } else {
                 int w = val.is_string()? static_cast<int>(std::stoul(val.get<string>(),nullptr,0))
                                         : val.get<int>();
-                memManager.write(addr, w, pcb); // Alterado aqui
+                image.push_back(static_cast<uint32_t>(w));
                 addr += 4;
             }
         }
@@ -234,7 +234,7 @@ int parseData(const json &dataJson, MemoryManager &memManager, PCB& pcb, int sta
             for (size_t i=0;i<bytes.size(); i+=4){
                 uint32_t w=0;
                 for (size_t j=0;j<4 && i+j<bytes.size(); ++j) w = (w<<8) | bytes[i+j];
-                memManager.write(addr, w, pcb); // Alterado aqui
+                image.push_back(static_cast<uint32_t>(w));
                 addr += 4;
             }
             bytes.clear();
@@ -250,13 +250,13 @@ int parseData(const json &dataJson, MemoryManager &memManager, PCB& pcb, int sta
                     for (auto &v : item["value"]){
                         int w = v.is_string()? static_cast<int>(std::stoul(v.get<string>(),nullptr,0))
                                              : v.get<int>();
-                        memManager.write(addr, w, pcb); // Alterado aqui
+                        image.push_back(static_cast<uint32_t>(w));
                         addr += 4;
                     }
                 } else {
                     int w = item["value"].is_string()? static_cast<int>(std::stoul(item["value"].get<string>(),nullptr,0))
                                                       : item["value"].get<int>();
-                    memManager.write(addr, w, pcb); // Alterado aqui
+                    image.push_back(static_cast<uint32_t>(w));
                     addr += 4;
                 }
             } else if (type=="byte"){
@@ -278,7 +278,7 @@ int parseData(const json &dataJson, MemoryManager &memManager, PCB& pcb, int sta
     return addr;
 }
 
-int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, int startAddr) {
+int parseProgram(const json &programJson, vector<uint32_t> &image, int startAddr) {
     if (!programJson.is_array()) {
         return startAddr;
     }
@@ -302,7 +302,7 @@ int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, i
         
         uint32_t binary_instruction = parseInstruction(node, current_instruction_addr);
         
-        memManager.write(current_mem_addr, binary_instruction, pcb); // Alterado aqui
+        image.push_back(binary_instruction);
         
         current_mem_addr += 4;
         current_instruction_addr++;
@@ -328,8 +328,12 @@ int loadJsonProgram(const string &filename, MemoryManager &memManager, PCB& pcb,
     // Salvar endereço inicial
     pcb.program_start_addr = startAddr;
     
-    if (j.contains("data"))    addr = parseData(j["data"], memManager, pcb, addr);
-    if (j.contains("program")) addr = parseProgram(j["program"], memManager, pcb, addr);
+    vector<uint32_t> image;
+    if (j.contains("data"))    addr = parseData(j["data"], image, addr);
+    if (j.contains("program")) addr = parseProgram(j["program"], image, addr);
+
+    // Imagem inteira de uma vez, sem passar pela cache nem pelos contadores do processo
+    memManager.loadImage(static_cast<uint32_t>(startAddr), image.data(), image.size(), pcb);
     
     // Calcular tamanho do programa carregado
     pcb.program_size = addr - startAddr;
@@ -338,4 +342,38 @@ int loadJsonProgram(const string &filename, MemoryManager &memManager, PCB& pcb,
     pcb.regBank.pc.write(pcb.program_start_addr);
     
     return addr;
+}
+
+int measureJsonProgram(const string &filename){
+    json j = readJsonFile(filename);
+    int words = 0;
+
+    if (j.contains("data")){
+        const json& dataJson = j["data"];
+        if (dataJson.is_object()){
+            for (auto it = dataJson.begin(); it != dataJson.end(); ++it){
+                words += it.value().is_array()? static_cast<int>(it.value().size()) : 1;
+            }
+        } else if (dataJson.is_array()){
+            int bytes = 0;
+            for (const auto &item : dataJson){
+                string type = toLower(item.value("type","word"));
+                const int count = item["value"].is_array()? static_cast<int>(item["value"].size()) : 1;
+                if (type=="word"){
+                    words += (bytes + 3) / 4;
+                    bytes = 0;
+                    words += count;
+                } else if (type=="byte"){
+                    bytes += count;
+                }
+            }
+            words += (bytes + 3) / 4;
+        }
+    }
+    if (j.contains("program") && j["program"].is_array()){
+        for (const auto &node : j["program"]){
+            if (node.contains("instruction")) words++;
+        }
+    }
+    return words * 4;
 }
\ No newline at end of file
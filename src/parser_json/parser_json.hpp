@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 #include "../nlohmann/json.hpp"
 
 // Forward declarations para evitar inclusões circulares
@@ -13,10 +14,13 @@ using nlohmann::json;
 // ===== API principal =====
 // Agora recebe MemoryManager e PCB para carregar o programa
 int loadJsonProgram(const std::string &filename, MemoryManager &memManager, PCB& pcb, int startAddr);
+// Endereços que loadJsonProgram ocuparia (dados + instruções), sem escrever na memória
+int measureJsonProgram(const std::string &filename);
 
 // ===== Parsers de seção =====
-int parseData(const json &dataJson, MemoryManager &memManager, PCB& pcb, int startAddr);
-int parseProgram(const json &programJson, MemoryManager &memManager, PCB& pcb, int startAddr);
+// Acrescentam as palavras em `image` e retornam o endereço seguinte
+int parseData(const json &dataJson, std::vector<uint32_t> &image, int startAddr);
+int parseProgram(const json &programJson, std::vector<uint32_t> &image, int startAddr);
 
 // ===== Parser de instrução =====
 uint32_t parseInstruction(const json &instrJson, int currentInstrIndex);
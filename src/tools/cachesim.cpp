@@ -0,0 +1,270 @@
+// cachesim - Reproduz um trace gravado com `simulador --trace` contra várias
+// configurações de cache em uma única passada:
+//   - LRU totalmente associativa de todos os tamanhos ao mesmo tempo (distância
+//     de pilha de Mattson, contada com uma árvore de Fenwick)
+//   - instâncias paralelas para as demais combinações (FIFO/LRU, associatividade)
+// Por padrão cada núcleo tem a sua cache, como a L1 do simulador, e as buscas de
+// instrução gravadas com a L1I separada ficam de fora (--fetches as inclui).
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "memory/MemoryTrace.hpp"
+#include "memory/ReuseProfiler.hpp"
+#include "memory/cache.hpp"
+#include "memory/cachePolicy.hpp"
+
+namespace {
+
+/**
+ * Distância de pilha LRU de um fluxo: quantas linhas distintas foram usadas desde o
+ * último acesso à mesma linha. Uma LRU totalmente associativa de C linhas acerta
+ * exatamente os acessos com distância < C. A Fenwick marca o último acesso de cada linha.
+ */
+class StackDistance {
+public:
+    static constexpr size_t COLD = SIZE_MAX;   // Primeiro acesso à linha
+
+    explicit StackDistance(size_t length) : marks(length) {}
+
+    size_t access(size_t line) {
+        size_t distance = COLD;
+        auto it = last.find(line);
+        if (it != last.end()) {
+            distance = static_cast<size_t>(marks.prefix(now) - marks.prefix(it->second + 1));
+            marks.add(it->second, -1);
+            it->second = now;
+        } else {
+            last.emplace(line, now);
+        }
+        marks.add(now, 1);
+        ++now;
+        return distance;
+    }
+
+private:
+    FenwickTree marks;
+    std::unordered_map<size_t, size_t> last;
+    size_t now = 0;
+};
+
+/**
+ * Cache de reprodução: mesmo mapeamento de conjuntos e mesma CachePolicy da L1 do
+ * simulador (write-allocate; sem prefetch e sem invalidações)
+ */
+class ReplayCache {
+public:
+    ReplayCache(size_t total_lines, size_t requested_ways, size_t line_size, ReplacementPolicy replacement)
+        : line_size(line_size), policy(replacement) {
+        ways = (requested_ways == 0 || requested_ways > total_lines) ? total_lines : requested_ways;
+        sets = total_lines / ways;
+        lines.assign(sets * ways, CacheLine{});
+    }
+
+    bool access(size_t address) {
+        const size_t base = address - (address % line_size);
+        auto it = index.find(base);
+        if (it != index.end()) {
+            lines[it->second].last_used = ++tick;
+            return true;
+        }
+        const size_t first = ((base / line_size) % sets) * ways;
+        const size_t victim = policy.selectVictim(lines, first, ways);
+        CacheLine& line = lines[victim];
+        if (line.isValid) index.erase(line.tag);
+        line.tag = base;
+        line.isValid = true;
+        line.inserted_at = ++tick;
+        line.last_used = tick;
+        index[base] = victim;
+        return false;
+    }
+
+private:
+    size_t line_size;
+    size_t ways;
+    size_t sets;
+    CachePolicy policy;
+    std::vector<CacheLine> lines;
+    std::unordered_map<size_t, size_t> index;
+    uint64_t tick = 0;
+};
+
+struct Config {
+    size_t lines;
+    size_t ways;
+    ReplacementPolicy policy;
+};
+
+std::vector<size_t> parseList(const std::string& text) {
+    std::vector<size_t> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) values.push_back(std::strtoull(item.c_str(), nullptr, 10));
+    }
+    return values;
+}
+
+void printHelp() {
+    std::cout << "Uso: ./bin/cachesim TRACE [opções]\n\n";
+    std::cout << "  TRACE                  Arquivo gravado com ./bin/simulador --trace TRACE\n";
+    std::cout << "  --line-size NUM        Endereços por linha (padrão: " << CACHE_LINE_SIZE << ")\n";
+    std::cout << "  --sizes LISTA          Tamanhos em linhas, ex.: 32,64,128 (padrão: 16 a 4096, potências de 2)\n";
+    std::cout << "  --ways LISTA           Associatividades das instâncias, 0 = total (padrão: 0)\n";
+    std::cout << "  --policies LISTA       Políticas das instâncias: fifo, lru (padrão: fifo)\n";
+    std::cout << "  --shared               Uma cache para todos os núcleos (padrão: uma por núcleo)\n";
+    std::cout << "  --pid NUM              Considera só os acessos deste PID\n";
+    std::cout << "  --core NUM             Considera só os acessos deste núcleo\n";
+    std::cout << "  --fetches              Inclui as buscas de instrução (L1 unificada)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string trace_file;
+    size_t line_size = CACHE_LINE_SIZE;
+    std::vector<size_t> sizes;
+    std::vector<size_t> ways_list{0};
+    std::vector<ReplacementPolicy> policies{ReplacementPolicy::FIFO};
+    bool shared = false;
+    int only_pid = -1;
+    int only_core = -1;
+    bool fetches = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printHelp();
+            return 0;
+        } else if (arg == "--line-size") {
+            if (i + 1 < argc) line_size = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--sizes") {
+            if (i + 1 < argc) sizes = parseList(argv[++i]);
+        } else if (arg == "--ways") {
+            if (i + 1 < argc) ways_list = parseList(argv[++i]);
+        } else if (arg == "--policies") {
+            policies.clear();
+            std::stringstream stream(i + 1 < argc ? argv[++i] : "");
+            std::string name;
+            while (std::getline(stream, name, ',')) {
+                policies.push_back(name == "lru" || name == "LRU" ? ReplacementPolicy::LRU : ReplacementPolicy::FIFO);
+            }
+        } else if (arg == "--shared") {
+            shared = true;
+        } else if (arg == "--pid") {
+            if (i + 1 < argc) only_pid = std::atoi(argv[++i]);
+        } else if (arg == "--core") {
+            if (i + 1 < argc) only_core = std::atoi(argv[++i]);
+        } else if (arg == "--fetches") {
+            fetches = true;
+        } else if (trace_file.empty()) {
+            trace_file = arg;
+        }
+    }
+    if (trace_file.empty()) {
+        printHelp();
+        return 1;
+    }
+    if (sizes.empty()) {
+        for (size_t lines = 16; lines <= 4096; lines *= 2) sizes.push_back(lines);
+    }
+    sizes.erase(std::remove(sizes.begin(), sizes.end(), size_t(0)), sizes.end());
+    if (sizes.empty()) {
+        std::cerr << "Nenhum tamanho de cache válido em --sizes\n";
+        return 1;
+    }
+    std::sort(sizes.begin(), sizes.end());
+
+    std::vector<TraceRecord> records;
+    try {
+        records = readTrace(trace_file);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    // Fluxos independentes: um por núcleo (caches privadas) ou um só (--shared)
+    std::vector<const TraceRecord*> accesses;
+    std::map<int, size_t> stream_length;
+    for (const TraceRecord& record : records) {
+        if (only_pid >= 0 && record.pid != only_pid) continue;
+        if (only_core >= 0 && record.core != only_core) continue;
+        if (!fetches && (record.flags & TRACE_FETCH)) continue;
+        accesses.push_back(&record);
+        ++stream_length[shared ? 0 : record.core];
+    }
+
+    std::vector<Config> configs;
+    for (ReplacementPolicy policy : policies) {
+        for (size_t ways : ways_list) {
+            for (size_t lines : sizes) configs.push_back(Config{lines, ways, policy});
+        }
+    }
+
+    // Uma única passada alimenta a pilha de Mattson e todas as instâncias
+    std::map<int, StackDistance> stacks;
+    std::map<int, std::vector<ReplayCache>> instances;
+    for (const auto& [stream, length] : stream_length) {
+        stacks.emplace(stream, StackDistance(length));
+        auto& caches = instances[stream];
+        for (const Config& config : configs) caches.emplace_back(config.lines, config.ways, line_size, config.policy);
+    }
+    const size_t largest = sizes.back();
+    std::vector<uint64_t> histogram(largest, 0);   // Acessos por distância < maior tamanho
+    uint64_t cold = 0;
+    uint64_t writes = 0;
+    std::vector<uint64_t> instance_hits(configs.size(), 0);
+
+    for (const TraceRecord* record : accesses) {
+        const int stream = shared ? 0 : record->core;
+        if (record->flags & TRACE_WRITE) ++writes;
+        const size_t distance = stacks.at(stream).access(record->address / line_size);
+        if (distance == StackDistance::COLD) ++cold;
+        else if (distance < largest) ++histogram[distance];
+
+        auto& caches = instances[stream];
+        for (size_t i = 0; i < caches.size(); ++i) {
+            if (caches[i].access(record->address)) ++instance_hits[i];
+        }
+    }
+
+    const uint64_t total = accesses.size();
+    std::cout << "Trace: " << trace_file << " (" << total << " acessos, " << writes << " escritas, "
+              << stream_length.size() << (shared ? " cache compartilhada" : " núcleo(s)") << ")\n";
+    std::cout << "Linha de " << line_size << " endereços; " << cold << " misses compulsórios\n\n";
+    if (total == 0) return 0;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "LRU totalmente associativa (distância de pilha):\n";
+    std::cout << "  " << std::setw(8) << "Linhas" << std::setw(12) << "Hits" << std::setw(12) << "Misses"
+              << std::setw(9) << "Miss %" << "\n";
+    uint64_t hits = 0;
+    size_t distance = 0;
+    for (size_t lines : sizes) {
+        while (distance < lines) hits += histogram[distance++];
+        std::cout << "  " << std::setw(8) << lines << std::setw(12) << hits << std::setw(12) << (total - hits)
+                  << std::setw(9) << (double)(total - hits) / total * 100.0 << "\n";
+    }
+
+    std::cout << "\nInstâncias:\n";
+    std::cout << "  " << std::setw(8) << "Linhas" << std::setw(8) << "Vias" << std::setw(10) << "Política"
+              << std::setw(12) << "Hits" << std::setw(12) << "Misses" << std::setw(9) << "Miss %" << "\n";
+    for (size_t i = 0; i < configs.size(); ++i) {
+        const Config& config = configs[i];
+        const size_t ways = (config.ways == 0 || config.ways > config.lines) ? config.lines : config.ways;
+        std::cout << "  " << std::setw(8) << config.lines << std::setw(8) << ways
+                  << std::setw(9) << (config.policy == ReplacementPolicy::LRU ? "lru" : "fifo")
+                  << std::setw(12) << instance_hits[i] << std::setw(12) << (total - instance_hits[i])
+                  << std::setw(9) << (double)(total - instance_hits[i]) / total * 100.0 << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef TEST_CHECK_HPP
+#define TEST_CHECK_HPP
+
+#include <iostream>
+
+// Verificações dos testes unitários: contam as falhas e seguem em frente
+inline int& test_failures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void test_check(bool ok, const char* expr, const char* file, int line) {
+    if (ok) return;
+    std::cerr << "  ❌ " << file << ":" << line << ": " << expr << "\n";
+    ++test_failures();
+}
+
+#define CHECK(cond) test_check((cond), #cond, __FILE__, __LINE__)
+#define CHECK_EQ(a, b) test_check((a) == (b), #a " == " #b, __FILE__, __LINE__)
+
+inline void test_section(const char* name) { std::cout << "  • " << name << "\n"; }
+
+// Resumo e código de saída do teste
+inline int test_summary(const char* name) {
+    if (test_failures() == 0) {
+        std::cout << "  ✅ " << name << ": todas as verificações passaram\n";
+        return 0;
+    }
+    std::cout << "  ❌ " << name << ": " << test_failures() << " verificação(ões) falharam\n";
+    return 1;
+}
+
+#endif // TEST_CHECK_HPP
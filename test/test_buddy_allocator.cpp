@@ -0,0 +1,150 @@
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "memory/BuddyAllocator.hpp"
+#include "TestCheck.hpp"
+
+namespace {
+
+// Estado das listas livres: um conjunto de offsets por ordem
+using FreeLists = std::vector<std::set<size_t>>;
+
+FreeLists free_lists(const BuddyAllocator& buddy) {
+    FreeLists lists;
+    for (unsigned order = 0; order <= buddy.maxOrder(); ++order) lists.push_back(buddy.freeBlocks(order));
+    return lists;
+}
+
+bool near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+// 1024 endereços = um bloco de ordem 4; dividir e liberar devolve o bloco inteiro
+void test_split_and_coalesce() {
+    test_section("Divisão e união: 1024 endereços voltam a um único bloco");
+    BuddyAllocator buddy(1000, 1024);
+    CHECK_EQ(buddy.maxOrder(), 4u);
+    CHECK(free_lists(buddy) == FreeLists({{}, {}, {}, {}, {0}}));
+
+    // 100 -> bloco de 128 (ordem 1); as metades de cima ficam livres
+    const size_t a = buddy.allocate(100);
+    CHECK_EQ(a, 1000u);
+    CHECK(free_lists(buddy) == FreeLists({{}, {128}, {256}, {512}, {}}));
+
+    FragmentationReport r = buddy.report();
+    CHECK_EQ(r.capacity, 1024u);
+    CHECK_EQ(r.segments, 1u);
+    CHECK_EQ(r.requested, 100u);
+    CHECK_EQ(r.allocated, 128u);
+    CHECK_EQ(r.free, 896u);
+    CHECK_EQ(r.largest_free, 512u);
+    CHECK(near(r.internal_pct(), 28.0 / 128.0 * 100.0));
+    CHECK(near(r.external_pct(), (1.0 - 512.0 / 896.0) * 100.0));
+
+    // 64 -> divide o bloco livre de 128 em [128, 192)
+    const size_t b = buddy.allocate(64);
+    CHECK_EQ(b, 1128u);
+    CHECK(free_lists(buddy) == FreeLists({{192}, {}, {256}, {512}, {}}));
+
+    // Buddy de `a` ainda dividido: não une
+    CHECK(buddy.release(a));
+    CHECK(free_lists(buddy) == FreeLists({{192}, {0}, {256}, {512}, {}}));
+
+    // `b` une em cascata até a ordem máxima
+    CHECK(buddy.release(b));
+    CHECK(free_lists(buddy) == FreeLists({{}, {}, {}, {}, {0}}));
+    r = buddy.report();
+    CHECK_EQ(r.segments, 0u);
+    CHECK_EQ(r.requested, 0u);
+    CHECK_EQ(r.allocated, 0u);
+    CHECK_EQ(r.free, 1024u);
+    CHECK_EQ(r.largest_free, 1024u);
+    CHECK(near(r.internal_pct(), 0.0));
+    CHECK(near(r.external_pct(), 0.0));
+
+    // Endereços que não são início de segmento vivo
+    CHECK(!buddy.release(a));          // Já liberado
+    CHECK(!buddy.release(a + 10));     // Meio do bloco
+    CHECK(!buddy.release(5000));       // Fora da região
+}
+
+// Pedido maior que o maior bloco (ou sem bloco livre que comporte) devolve NO_SEGMENT
+void test_no_segment() {
+    test_section("NO_SEGMENT: pedido maior que o maior bloco livre");
+    BuddyAllocator buddy(0, 1024);
+    CHECK_EQ(buddy.allocate(1025), NO_SEGMENT);
+    CHECK(free_lists(buddy) == FreeLists({{}, {}, {}, {}, {0}}));
+
+    const size_t all = buddy.allocate(1024);
+    CHECK_EQ(all, 0u);
+    CHECK_EQ(buddy.allocate(1), NO_SEGMENT);
+    CHECK_EQ(buddy.report().free, 0u);
+    CHECK(near(buddy.report().external_pct(), 0.0));
+
+    // Pedido vazio ocupa o menor bloco e conta como 1 endereço pedido
+    CHECK(buddy.release(all));
+    CHECK_EQ(buddy.allocate(0), 0u);
+    CHECK_EQ(buddy.report().requested, 1u);
+    CHECK_EQ(buddy.report().allocated, static_cast<size_t>(BUDDY_MIN_BLOCK));
+}
+
+// 1000 endereços: blocos de 512, 256, 128 e 64; o resto (40) fica sem uso
+void test_non_power_of_two() {
+    test_section("Região que não é potência de 2: vários blocos de topo");
+    BuddyAllocator buddy(0, 1000);
+    CHECK_EQ(buddy.maxOrder(), 3u);
+    CHECK(free_lists(buddy) == FreeLists({{896}, {768}, {512}, {0}}));
+
+    FragmentationReport r = buddy.report();
+    CHECK_EQ(r.capacity, 1000u);
+    CHECK_EQ(r.free, 960u);
+    CHECK_EQ(r.largest_free, 512u);
+    CHECK(near(r.external_pct(), (1.0 - 512.0 / 960.0) * 100.0));
+
+    // 960 livres, mas nenhum bloco comporta 600
+    CHECK_EQ(buddy.allocate(600), NO_SEGMENT);
+
+    const size_t big = buddy.allocate(512);
+    const size_t mid = buddy.allocate(200);
+    CHECK_EQ(big, 0u);
+    CHECK_EQ(mid, 512u);
+    CHECK(free_lists(buddy) == FreeLists({{896}, {768}, {}, {}}));
+
+    // Blocos de topo vizinhos não são buddies: liberar não une [0, 512) com [512, 768)
+    CHECK(buddy.release(big));
+    CHECK(buddy.release(mid));
+    CHECK(free_lists(buddy) == FreeLists({{896}, {768}, {512}, {0}}));
+    CHECK_EQ(buddy.report().free, 960u);
+}
+
+// Relatório somado de dois alocadores (como o MemoryManager faz)
+void test_report_merge() {
+    test_section("FragmentationReport::merge soma as regiões e mantém o maior bloco livre");
+    BuddyAllocator first(0, 1024);
+    BuddyAllocator second(1024, 512);
+    first.allocate(300);    // Bloco de 512
+    second.allocate(64);    // Bloco de 64
+
+    FragmentationReport total = first.report();
+    total.merge(second.report());
+    CHECK_EQ(total.capacity, 1536u);
+    CHECK_EQ(total.segments, 2u);
+    CHECK_EQ(total.requested, 364u);
+    CHECK_EQ(total.allocated, 576u);
+    CHECK_EQ(total.free, 960u);
+    CHECK_EQ(total.largest_free, 512u);
+    CHECK(near(total.internal_pct(), (576.0 - 364.0) / 576.0 * 100.0));
+}
+
+} // namespace
+
+int main() {
+    std::cout << "\n==============================================================\n";
+    std::cout << "  TESTE: alocador buddy (divisão, união e fragmentação)\n";
+    std::cout << "==============================================================\n";
+    test_split_and_coalesce();
+    test_no_segment();
+    test_non_power_of_two();
+    test_report_merge();
+    return test_summary("Alocador buddy");
+}
@@ -0,0 +1,163 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "memory/DramModel.hpp"
+#include "TestCheck.hpp"
+
+namespace {
+
+// Um banco, linhas de 16 endereços: 0..15 é a linha 0, 16..31 a linha 1, ...
+DramConfig one_bank() {
+    DramConfig cfg;
+    cfg.channels = 1;
+    cfg.banks = 1;
+    cfg.row_words = 16;
+    cfg.t_hit = 2;
+    cfg.t_miss = 5;
+    cfg.t_conflict = 9;
+    cfg.queue_depth = 1000;
+    cfg.hit_streak_cap = 4;
+    return cfg;
+}
+
+struct Counts {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t conflicts = 0;
+    std::vector<uint64_t> latencies;
+};
+
+// Acessos espaçados (sem fila): só a classificação do row buffer importa
+Counts run(DramModel& dram, const std::vector<uint32_t>& addresses) {
+    Counts counts;
+    uint64_t now = 0;
+    for (uint32_t address : addresses) {
+        const DramAccess access = dram.access(address, now);
+        CHECK_EQ(access.queue_delay, 0u);
+        switch (access.outcome) {
+            case RowOutcome::Hit:      ++counts.hits; break;
+            case RowOutcome::Conflict: ++counts.conflicts; break;
+            default:                   ++counts.misses; break;
+        }
+        counts.latencies.push_back(access.latency);
+        now += 100;
+    }
+    return counts;
+}
+
+// Dois bancos: bloco par no banco 0, ímpar no banco 1; linha = bloco / 2
+void test_open_page() {
+    test_section("Página aberta: hit, banco vazio e conflito com as latências de cada um");
+    DramConfig cfg = one_bank();
+    cfg.banks = 2;
+    DramModel dram(cfg);
+    //  0: banco 0 vazio (miss)      4: linha 0 aberta (hit)   32: linha 1 no banco 0 (conflito)
+    // 16: banco 1 vazio (miss)     36: linha 1 aberta (hit)    8: linha 0 de novo (conflito)
+    const Counts counts = run(dram, {0, 4, 32, 16, 36, 8});
+    CHECK_EQ(counts.hits, 2u);
+    CHECK_EQ(counts.misses, 2u);
+    CHECK_EQ(counts.conflicts, 2u);
+    CHECK(counts.latencies == std::vector<uint64_t>({5, 2, 9, 5, 2, 9}));
+    CHECK_EQ(dram.clock(), 500u);
+}
+
+// Mesmos endereços com precharge após cada acesso: tudo é miss
+void test_closed_page() {
+    test_section("Página fechada: sem hits nem conflitos, toda leitura paga a ativação");
+    DramConfig cfg = one_bank();
+    cfg.banks = 2;
+    cfg.policy = RowPolicy::Closed;
+    DramModel dram(cfg);
+    const Counts counts = run(dram, {0, 4, 32, 16, 36, 8});
+    CHECK_EQ(counts.hits, 0u);
+    CHECK_EQ(counts.misses, 6u);
+    CHECK_EQ(counts.conflicts, 0u);
+    CHECK(counts.latencies == std::vector<uint64_t>(6, 5));
+
+    CHECK(DramModel::parsePolicy("Closed") == RowPolicy::Closed);
+    CHECK(DramModel::parsePolicy("open") == RowPolicy::Open);
+    CHECK(std::string(DramModel::policyName(RowPolicy::Closed)) == "closed");
+}
+
+// Canais intercalam os blocos antes dos bancos: blocos vizinhos não disputam o row buffer
+void test_channel_interleave() {
+    test_section("Canais: blocos vizinhos em canais diferentes não geram conflito");
+    DramConfig cfg = one_bank();
+    cfg.channels = 2;
+    DramModel dram(cfg);
+    // 0 e 16 caem em canais diferentes, ambos na linha 0; 32 é a linha 1 do canal 0
+    const Counts counts = run(dram, {0, 16, 4, 20, 32});
+    CHECK_EQ(counts.misses, 2u);
+    CHECK_EQ(counts.hits, 2u);
+    CHECK_EQ(counts.conflicts, 1u);
+}
+
+// Pedido de um núcleo atrasado atrás de um banco ocupado até muito à frente
+void test_queue_depth() {
+    test_section("queue_depth: a espera na fila do banco é limitada a uma fila cheia");
+    DramConfig cfg = one_bank();
+    DramModel unlimited(cfg);
+    CHECK_EQ(unlimited.access(0, 1000).queue_delay, 0u);   // Banco ocupado até 1005
+    DramAccess late = unlimited.access(16, 0);
+    CHECK(late.outcome == RowOutcome::Conflict);
+    CHECK_EQ(late.queue_delay, 1005u);
+    CHECK_EQ(late.latency, 9u);
+
+    cfg.queue_depth = 2;   // No máximo 2 * t_conflict de espera
+    DramModel limited(cfg);
+    CHECK_EQ(limited.access(0, 1000).queue_delay, 0u);
+    late = limited.access(16, 0);
+    CHECK(late.outcome == RowOutcome::Conflict);
+    CHECK_EQ(late.queue_delay, 18u);
+    CHECK_EQ(late.latency, 9u);
+    CHECK_EQ(limited.clock(), 1000u);
+}
+
+// Sequência fixa: banco ocupado até 105 por um núcleo adiantado; um núcleo atrasado
+// troca a linha (limitado pela fila) e depois manda hits à linha que abriu
+std::vector<uint64_t> hit_delays(size_t hit_streak_cap) {
+    DramConfig cfg = one_bank();
+    cfg.queue_depth = 8;   // Espera máxima de 72
+    cfg.hit_streak_cap = hit_streak_cap;
+    DramModel dram(cfg);
+    dram.access(0, 100);                          // Linha 0, termina em 105
+    const DramAccess opened = dram.access(16, 0); // Linha 1: limitado a começar em 72
+    CHECK(opened.outcome == RowOutcome::Conflict);
+    CHECK_EQ(opened.queue_delay, 72u);            // Termina em 81
+
+    std::vector<uint64_t> delays;
+    for (uint32_t address : {20u, 24u, 28u, 20u}) {
+        const DramAccess hit = dram.access(address, 80);
+        CHECK(hit.outcome == RowOutcome::Hit);
+        CHECK_EQ(hit.latency, 2u);
+        delays.push_back(hit.queue_delay);
+    }
+    return delays;
+}
+
+void test_hit_streak_cap() {
+    test_section("FR-FCFS: hits furam a fila até hit_streak_cap vezes seguidas");
+    // Dois hits passam à frente do pedido que termina em 105 (começam em 81 e 83);
+    // o terceiro espera a fila (105 + 2 + 2 = 109) e zera a sequência
+    CHECK(hit_delays(2) == std::vector<uint64_t>({1, 3, 29, 31}));
+    // Sem limite prático, todos os hits seguem logo após o anterior
+    CHECK(hit_delays(10) == std::vector<uint64_t>({1, 3, 5, 7}));
+    // hit_streak_cap = 0: FCFS puro, o primeiro hit já espera a fila
+    CHECK(hit_delays(0) == std::vector<uint64_t>({25, 27, 29, 31}));
+}
+
+} // namespace
+
+int main() {
+    std::cout << "\n==============================================================\n";
+    std::cout << "  TESTE: modelo de DRAM (row buffer, políticas e fila por banco)\n";
+    std::cout << "==============================================================\n";
+    test_open_page();
+    test_closed_page();
+    test_channel_interleave();
+    test_queue_depth();
+    test_hit_streak_cap();
+    return test_summary("Modelo de DRAM");
+}
@@ -0,0 +1,224 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "IO/IOManager.hpp"
+#include "IO/MpscQueue.hpp"
+#include "cpu/IOCompletionQueue.hpp"
+#include "cpu/PCB.hpp"
+#include "TestCheck.hpp"
+
+namespace {
+
+constexpr int PRODUCERS = 4;
+
+// Cada produtor empilha valores próprios; o consumidor roda ao mesmo tempo
+void test_mpsc_queue() {
+    test_section("MpscQueue: vários produtores, cada item exatamente uma vez e em ordem por produtor");
+    constexpr int ITEMS = 20000;
+    MpscQueue<int> queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < ITEMS; ++i) queue.push(p * ITEMS + i);
+        });
+    }
+
+    std::vector<int> seen(PRODUCERS * ITEMS, 0);
+    std::vector<int> last(PRODUCERS, -1);
+    bool ordered = true;
+    int received = 0;
+    int value = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (received < PRODUCERS * ITEMS && std::chrono::steady_clock::now() < deadline) {
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ++seen[value];
+        ordered = ordered && value > last[value / ITEMS];
+        last[value / ITEMS] = value;
+        ++received;
+    }
+    for (auto& producer : producers) producer.join();
+
+    CHECK_EQ(received, PRODUCERS * ITEMS);
+    CHECK(ordered);
+    bool once = true;
+    for (int count : seen) once = once && count == 1;
+    CHECK(once);
+    CHECK(!queue.pop(value));
+    CHECK(queue.empty());
+}
+
+// Rajadas separadas por pausas: a thread de eventos dorme entre elas e precisa ser acordada
+void test_submit_wakeup() {
+    test_section("IOManager: submit de vários núcleos com a thread de eventos dormindo e acordando");
+    constexpr int BURSTS = 20;
+    constexpr int PER_BURST = 8;
+    constexpr int TOTAL = PRODUCERS * BURSTS * PER_BURST;
+
+    std::vector<std::unique_ptr<PCB>> processes;
+    for (int i = 0; i < TOTAL; ++i) {
+        processes.push_back(std::make_unique<PCB>());
+        processes.back()->pid = i;
+    }
+    std::vector<std::atomic<int>> completions(TOTAL);
+    for (auto& count : completions) count.store(0);
+
+    {
+        IOManager io;
+        std::vector<std::thread> cores;
+        for (int c = 0; c < PRODUCERS; ++c) {
+            cores.emplace_back([&, c] {
+                int next = c;
+                for (int burst = 0; burst < BURSTS; ++burst) {
+                    for (int i = 0; i < PER_BURST; ++i, next += PRODUCERS) {
+                        auto request = std::make_unique<IORequest>();
+                        request->process = processes[next].get();
+                        request->pid = next;
+                        request->device = IODevice::Printer;
+                        request->on_complete = [&completions](PCB* process) { completions[process->pid]++; };
+                        io.submit(std::move(request), 100 + next);
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1 + (burst + c) % 3));
+                }
+            });
+        }
+        for (auto& core : cores) core.join();
+
+        auto drained = std::async(std::launch::async, [&io] { io.waitForCompletions(); });
+        const bool returned = drained.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+        CHECK(returned);
+        if (!returned) {
+            std::cerr << "  waitForCompletions() não retornou; abortando\n";
+            std::exit(1);
+        }
+        CHECK_EQ(io.getRequestCount(), 0u);
+    }
+
+    bool once = true;
+    bool timed = true;
+    for (int i = 0; i < TOTAL; ++i) {
+        once = once && completions[i].load() == 1;
+        // Conclusão no relógio simulado, depois da chegada
+        timed = timed && processes[i]->io_ready_at.load() > static_cast<uint64_t>(100 + i);
+    }
+    CHECK(once);
+    CHECK(timed);
+}
+
+// Sem callback, o próprio IOManager devolve o processo a Ready
+void test_register_without_callback() {
+    test_section("IOManager: registerProcessWaitingForIO sem callback marca o processo como Ready");
+    PCB process;
+    process.pid = 1;
+    process.state = State::Blocked;
+    {
+        IOManager io;
+        io.registerProcessWaitingForIO(&process, 50);
+        io.waitForCompletions();
+    }
+    CHECK(process.state == State::Ready);
+    CHECK(process.io_ready_at.load() > 50);
+}
+
+// Conclusão entregue antes de o escalonador coletar o processo do núcleo
+void test_completion_before_collect() {
+    test_section("IOCompletionQueue: conclusão antes da coleta fica guardada até o processo bloquear");
+    PCB early, blocked, other;
+    early.pid = 1;
+    blocked.pid = 2;
+    other.pid = 3;
+    early.state = State::Blocked;
+    blocked.state = State::Blocked;
+    other.state = State::Blocked;
+
+    IOCompletionQueue completions;
+    std::vector<PCB*> blocked_list = {&other, &blocked};
+    std::vector<PCB*> ready;
+    auto make_ready = [&ready](PCB* process) {
+        process->state = State::Ready;
+        ready.push_back(process);
+    };
+
+    completions.push(&early);     // Ainda no núcleo
+    completions.push(&blocked);
+    completions.release(blocked_list, make_ready);
+    CHECK_EQ(ready.size(), 1u);
+    CHECK(blocked.state == State::Ready);
+    CHECK(early.state == State::Blocked);
+    CHECK_EQ(completions.waiting(), 1u);
+    CHECK(blocked_list == std::vector<PCB*>({&other}));
+
+    blocked_list.push_back(&early);   // Coleta do núcleo
+    completions.release(blocked_list, make_ready);
+    CHECK(early.state == State::Ready);
+    CHECK_EQ(completions.waiting(), 0u);
+    CHECK(blocked_list == std::vector<PCB*>({&other}));
+    CHECK(other.state == State::Blocked);
+
+    // Também com a deque do Round Robin; a ordem dos que continuam bloqueados é mantida
+    PCB a, b, c;
+    std::deque<PCB*> queue = {&a, &b, &c};
+    completions.push(&b);
+    completions.release(queue, make_ready);
+    CHECK(queue == std::deque<PCB*>({&a, &c}));
+    CHECK(b.state == State::Ready);
+}
+
+// Fluxo completo: o callback chega pela thread de eventos antes da coleta
+void test_completion_race_end_to_end() {
+    test_section("IOManager + IOCompletionQueue: processo termina Ready mesmo com a conclusão adiantada");
+    PCB process;
+    process.pid = 7;
+    process.state = State::Blocked;
+    IOCompletionQueue completions;
+    {
+        IOManager io;
+        auto request = std::make_unique<IORequest>();
+        request->process = &process;
+        request->pid = process.pid;
+        request->device = IODevice::Printer;
+        request->on_complete = [&completions](PCB* done) { completions.push(done); };
+        io.submit(std::move(request), 10);
+        io.waitForCompletions();   // Entregue enquanto o "núcleo" ainda não foi coletado
+    }
+
+    std::vector<PCB*> blocked_list;
+    int released = 0;
+    auto make_ready = [&released](PCB* done) {
+        done->state = State::Ready;
+        ++released;
+    };
+    completions.release(blocked_list, make_ready);
+    CHECK_EQ(released, 0);
+    CHECK_EQ(completions.waiting(), 1u);
+
+    blocked_list.push_back(&process);
+    completions.release(blocked_list, make_ready);
+    CHECK_EQ(released, 1);
+    CHECK(process.state == State::Ready);
+    CHECK(blocked_list.empty());
+    CHECK_EQ(completions.waiting(), 0u);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "\n==============================================================\n";
+    std::cout << "  TESTE: entrega de I/O (MpscQueue, IOManager, IOCompletionQueue)\n";
+    std::cout << "==============================================================\n";
+    test_mpsc_queue();
+    test_submit_wakeup();
+    test_register_without_callback();
+    test_completion_before_collect();
+    test_completion_race_end_to_end();
+    return test_summary("Entrega de I/O");
+}
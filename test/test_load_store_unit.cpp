@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <iostream>
+
+#include "memory/LoadStoreUnit.hpp"
+#include "TestCheck.hpp"
+
+namespace {
+
+constexpr size_t LINE = 16;
+
+LsuConfig config(size_t store_buffer, size_t mshrs) {
+    LsuConfig cfg;
+    cfg.store_buffer = store_buffer;
+    cfg.mshrs = mshrs;
+    return cfg;
+}
+
+// Sem store buffer o SW espera a escrita inteira
+void test_store_without_buffer() {
+    test_section("SW sem store buffer: espera a latência inteira");
+    LoadStoreUnit lsu(config(0, 0), LINE);
+    CHECK_EQ(lsu.store(0x00, 12, 0), 12u);
+    CHECK_EQ(lsu.drain(12), 0u);
+    const LsuStats stats = lsu.takeStats();
+    CHECK_EQ(stats.latency, 12u);
+    CHECK_EQ(stats.stalls, 12u);
+}
+
+// Buffer de 2 entradas drenando em ordem: o terceiro SW espera o mais antigo sair
+void test_full_store_buffer() {
+    test_section("Store buffer cheio: para até a escrita mais antiga drenar");
+    LoadStoreUnit lsu(config(2, 0), LINE);
+    CHECK_EQ(lsu.store(0x00, 10, 0), 0u);   // Termina em 10
+    CHECK_EQ(lsu.store(0x04, 10, 0), 0u);   // Começa em 10, termina em 20
+    CHECK_EQ(lsu.store(0x08, 10, 0), 10u);  // Cheio: espera até 10; termina em 30
+    // A entrada liberada em 10 já abre espaço sem nova espera
+    CHECK_EQ(lsu.store(0x0C, 10, 20), 0u);  // Em 20 só a de 30 continua; termina em 40
+    CHECK_EQ(lsu.drain(20), 20u);           // Resta a escrita que termina em 40
+
+    const LsuStats stats = lsu.takeStats();
+    CHECK_EQ(stats.latency, 40u);
+    CHECK_EQ(stats.stalls, 30u);
+    CHECK_EQ(lsu.takeStats().stalls, 0u);   // takeStats zera os contadores
+}
+
+// LW da mesma palavra recebe o dado do buffer; outra palavra da linha não espera a escrita
+void test_store_to_load_forwarding() {
+    test_section("Store-to-load forwarding: LW de palavra no buffer conta forward");
+    LoadStoreUnit lsu(config(4, 0), LINE);
+    CHECK_EQ(lsu.store(0x40, 30, 0), 0u);       // No buffer até 30
+
+    CHECK_EQ(lsu.load(0x40, 5, true, 1, 3), 5u);   // Forward: só a latência própria
+    LsuStats stats = lsu.takeStats();
+    CHECK_EQ(stats.forwards, 1u);
+    CHECK_EQ(stats.merges, 0u);
+
+    // Mesma linha, outra palavra: o store buffer não torna a linha indisponível
+    CHECK_EQ(lsu.load(0x44, 5, false, 6, 3), 5u);
+    stats = lsu.takeStats();
+    CHECK_EQ(stats.forwards, 0u);
+    CHECK_EQ(stats.merges, 0u);
+
+    // Depois de drenada a escrita, o LW volta ao caminho normal
+    CHECK_EQ(lsu.load(0x40, 5, false, 30, 3), 5u);
+    stats = lsu.takeStats();
+    CHECK_EQ(stats.forwards, 0u);
+    CHECK_EQ(stats.merges, 0u);
+}
+
+// mshrs=2: dois misses se sobrepõem sem parar; o terceiro espera o que termina antes
+void test_mshr_overlap() {
+    test_section("MSHRs: dois misses se sobrepõem e o terceiro espera o mais cedo");
+    LoadStoreUnit lsu(config(0, 2), LINE);
+    CHECK_EQ(lsu.load(0x100, 50, true, 0, 1), 0u);   // Pronto em 50
+    CHECK_EQ(lsu.load(0x200, 30, true, 0, 2), 0u);   // Pronto em 30 (sobreposto)
+    CHECK_EQ(lsu.load(0x300, 40, true, 0, 3), 30u);  // Espera o de 30; pronto em 70
+
+    // Miss na linha de um MSHR ocupado se junta a ele em vez de ocupar outro
+    CHECK_EQ(lsu.load(0x104, 50, true, 30, 4), 0u);
+    LsuStats stats = lsu.takeStats();
+    CHECK_EQ(stats.merges, 1u);
+    CHECK_EQ(stats.stalls, 30u);
+    CHECK_EQ(stats.latency, 170u);
+
+    // Hit não ocupa MSHR; o registrador só fica pendente pela latência dele
+    CHECK_EQ(lsu.load(0x500, 2, false, 30, 5), 0u);
+    // Leitura bloqueante (dest < 0) espera o próprio dado
+    CHECK_EQ(lsu.load(0x600, 2, false, 30, -1), 2u);
+}
+
+// O scoreboard só para quem lê um registrador de destino ainda pendente
+void test_wait_operands() {
+    test_section("waitOperands: para só com registrador de destino pendente");
+    LoadStoreUnit lsu(config(0, 2), LINE);
+    CHECK_EQ(lsu.load(0x100, 50, true, 0, 1), 0u);   // x1 pronto em 50
+    CHECK_EQ(lsu.load(0x200, 20, true, 0, 2), 0u);   // x2 pronto em 20
+
+    const uint32_t independent[] = {4, 5};
+    CHECK_EQ(lsu.waitOperands(independent, 2, 5), 0u);
+    const uint32_t reads_x2[] = {2, 6};
+    CHECK_EQ(lsu.waitOperands(reads_x2, 2, 10), 10u);   // 10 -> 20
+    CHECK_EQ(lsu.waitOperands(reads_x2, 2, 25), 0u);    // Já chegou
+    const uint32_t reads_x1[] = {1};
+    CHECK_EQ(lsu.waitOperands(reads_x1, 1, 30), 20u);   // 30 -> 50
+    CHECK_EQ(lsu.waitOperands(reads_x1, 1, 50), 0u);
+    CHECK_EQ(lsu.takeStats().stalls, 30u);
+
+    // LW x3 seguido de uma instrução de ULA que escreve x3: quem lê x3 não espera o LW
+    CHECK_EQ(lsu.load(0x300, 40, true, 50, 3), 0u);    // x3 pronto em 90
+    lsu.clearRegister(3);
+    const uint32_t reads_x3[] = {3};
+    CHECK_EQ(lsu.waitOperands(reads_x3, 1, 51), 0u);
+    // O miss continua ocupando o MSHR até chegar
+    CHECK_EQ(lsu.drain(51), 39u);
+}
+
+// drain() espera o que ainda está em andamento e esvazia a unidade
+void test_drain() {
+    test_section("drain: devolve a latência restante e esvazia a unidade");
+    LoadStoreUnit lsu(config(2, 2), LINE);
+    CHECK_EQ(lsu.store(0x00, 10, 0), 0u);            // Termina em 10
+    CHECK_EQ(lsu.load(0x100, 40, true, 0, 1), 0u);   // x1 pronto em 40
+    CHECK_EQ(lsu.drain(15), 25u);                    // 15 -> 40
+    CHECK_EQ(lsu.drain(40), 0u);                     // Nada pendente
+
+    // Depois do drain o registrador não está mais pendente nem a linha a caminho
+    const uint32_t reads_x1[] = {1};
+    CHECK_EQ(lsu.waitOperands(reads_x1, 1, 40), 0u);
+    CHECK_EQ(lsu.load(0x104, 5, false, 40, -1), 5u);
+    const LsuStats stats = lsu.takeStats();
+    CHECK_EQ(stats.merges, 0u);
+    CHECK_EQ(stats.stalls, 30u);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "\n==============================================================\n";
+    std::cout << "  TESTE: unidade de load/store (store buffer, MSHRs, scoreboard)\n";
+    std::cout << "==============================================================\n";
+    test_store_without_buffer();
+    test_full_store_buffer();
+    test_store_to_load_forwarding();
+    test_mshr_overlap();
+    test_wait_operands();
+    test_drain();
+    return test_summary("Unidade de load/store");
+}
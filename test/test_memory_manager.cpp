@@ -0,0 +1,183 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "cpu/PCB.hpp"
+#include "memory/MemoryManager.hpp"
+#include "TestCheck.hpp"
+
+namespace {
+
+constexpr size_t RAM_WORDS = 4096;
+constexpr size_t DISK_WORDS = 8192;
+
+bool near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+// Laço com passo fixo, três escritas para cada leitura, com prefetch por passo na L1
+void test_prefetch_coverage_writes() {
+    test_section("Cobertura do prefetch: escritas contam igual no global e no PCB");
+    MemoryManager memory(RAM_WORDS, DISK_WORDS);
+    CacheConfig config;
+    config.lines = 16;
+    config.prefetch = PrefetchPolicy::Stride;
+    config.prefetch_degree = 2;
+    Cache l1(config);
+    MemoryManager::setThreadCache(&l1);
+    MemoryManager::resetStats();
+
+    PCB process;
+    process.pid = 1;
+    for (uint32_t i = 0; i < 256; ++i) {
+        const uint32_t address = i * CACHE_LINE_SIZE;   // Uma linha nova por acesso
+        if (i % 4 == 3) memory.read(address, process);
+        else memory.write(address, i, process);
+    }
+    MemoryManager::setThreadCache(nullptr);
+
+    const MemoryStats stats = MemoryManager::getStats();
+    CHECK(stats.prefetch_useful > 0);
+    CHECK_EQ(stats.prefetch_useful, process.prefetch_hits.load());
+    CHECK_EQ(stats.cache_hits, process.cache_hits.load());
+    CHECK_EQ(stats.cache_misses, process.cache_misses.load());
+    CHECK_EQ(stats.cache_hits + stats.cache_misses, 256u);
+    CHECK(stats.get_prefetch_coverage() <= 100.0);
+    CHECK(near(stats.get_prefetch_coverage(), process.get_prefetch_coverage() * 100.0));
+}
+
+// Classes da L2: as pedidas no JSON ficam reservadas; sem classe livre o processo é avisado
+void test_cache_class_reservation() {
+    test_section("Classes da L2: classe explícita reservada e aviso quando as próprias acabam");
+    MemoryManager memory(RAM_WORDS, DISK_WORDS);
+    SharedCacheConfig l2;
+    l2.lines = 64;
+    l2.ways = 8;
+    memory.enableSharedCache(l2);
+
+    PCB chosen, own;
+    chosen.pid = 1;
+    chosen.cache_class = L2_MAX_CLASSES - 1;   // A primeira que seria dada como própria
+    chosen.cache_mask = 0x03;
+    own.pid = 2;
+    own.cache_mask = 0x0c;
+    memory.reserveCacheClass(chosen.cache_class);
+    memory.reserveCacheClass(own.cache_class);   // Sem classe pedida: nada a reservar
+
+    memory.assignCacheClass(own);                // Admitido antes do dono da classe
+    memory.assignCacheClass(chosen);
+    CHECK_EQ(own.cache_class, L2_MAX_CLASSES - 2);
+    CHECK_EQ(chosen.cache_class, L2_MAX_CLASSES - 1);
+    CHECK_EQ(memory.getSharedCache()->getMask(L2_MAX_CLASSES - 1), 0x03u);
+    CHECK_EQ(memory.getSharedCache()->getMask(L2_MAX_CLASSES - 2), 0x0cu);
+
+    // Restam as classes 1..L2_MAX_CLASSES-3; a seguinte fica na classe 0 sem mudar a máscara dela
+    std::vector<PCB> others(L2_MAX_CLASSES - 2);
+    for (size_t i = 0; i < others.size(); ++i) {
+        others[i].pid = static_cast<int>(10 + i);
+        others[i].cache_mask = 0x30;
+        memory.assignCacheClass(others[i]);
+    }
+    CHECK_EQ(others[others.size() - 2].cache_class, 1);
+    CHECK_EQ(others.back().cache_class, -1);
+    CHECK_EQ(memory.getSharedCache()->getMask(0), memory.getSharedCache()->fullMask());
+}
+
+// Linha pré-buscada para a L1 também entra na L2, na partição da classe do processo
+void test_prefetch_fills_l2() {
+    test_section("Prefetch passa pela L2: tags, ocupação da classe e hit depois");
+    MemoryManager memory(RAM_WORDS, DISK_WORDS);
+    SharedCacheConfig l2;
+    l2.lines = 64;
+    l2.ways = 8;
+    memory.enableSharedCache(l2);
+    CacheConfig config;
+    config.lines = 16;
+    config.prefetch = PrefetchPolicy::NextLine;
+    Cache l1(config);
+    MemoryManager::setThreadCache(&l1);
+
+    PCB process;
+    process.pid = 1;
+    process.cache_mask = 0x0f;
+    memory.assignCacheClass(process);
+    memory.read(0, process);                       // Miss de demanda + prefetch da linha 16
+
+    size_t occupancy = 0;
+    for (const SharedCacheClassStats& stats : memory.getSharedCache()->classStats()) {
+        if (stats.clos == process.cache_class) occupancy = stats.occupancy;
+    }
+    CHECK_EQ(occupancy, 2u);
+    CHECK_EQ(process.l2_misses.load(), 1u);       // Só a demanda é do processo
+
+    // Fora da L1, a linha pré-buscada ainda acerta na L2
+    l1.invalidate();
+    memory.read(CACHE_LINE_SIZE, process);
+    CHECK_EQ(process.l2_hits.load(), 1u);
+    MemoryManager::setThreadCache(nullptr);
+}
+
+// Duas instâncias do mesmo programa (como com SHARE_IMAGES): imagem de duas páginas
+// nos mesmos slots de swap; só a página escrita ganha cópia privada
+void test_copy_on_write() {
+    test_section("Copy-on-write: a escrita de um processo não aparece no outro");
+    MemoryManager memory(RAM_WORDS, DISK_WORDS);
+    memory.enableVirtualMemory(TLBConfig{});
+    MemoryManager::setThreadCache(nullptr);
+
+    PCB first, second;
+    first.pid = 1;
+    second.pid = 2;
+    memory.attachAddressSpace(first);
+    memory.attachAddressSpace(second);
+
+    const size_t words = 2 * VM_PAGE_SIZE / IMAGE_WORD_STRIDE;
+    std::vector<uint32_t> image(words);
+    for (size_t i = 0; i < words; ++i) image[i] = static_cast<uint32_t>(100 + i);
+    memory.loadImage(0, image.data(), words, first);
+    first.program_start_addr = 0;
+    first.program_size = static_cast<uint32_t>(words * IMAGE_WORD_STRIDE);
+    CHECK(memory.shareImage(first, second));
+
+    const uint32_t text_slot = first.address_space->find(0)->swap_slot;
+    const uint32_t data_slot = first.address_space->find(1)->swap_slot;
+    CHECK_EQ(second.address_space->find(1)->swap_slot, data_slot);
+    CHECK_EQ(memory.swapSlotRefs(text_slot), 2u);
+    CHECK_EQ(memory.swapSlotRefs(data_slot), 2u);
+
+    // Os dois leem a página de dados: um quadro só, mapeado pelos dois
+    const uint32_t data = VM_PAGE_SIZE;   // Primeira palavra da página 1
+    CHECK_EQ(memory.read(data, first), 100u + VM_PAGE_SIZE / IMAGE_WORD_STRIDE);
+    CHECK_EQ(memory.read(data, second), 100u + VM_PAGE_SIZE / IMAGE_WORD_STRIDE);
+    CHECK(memory.hasSharedFrame(data_slot));
+    CHECK_EQ(first.address_space->find(1)->frame, second.address_space->find(1)->frame);
+
+    // breakCow: o segundo escreve e fica com um quadro próprio
+    memory.write(data, 7, second);
+    CHECK_EQ(second.cow_copies.load(), 1u);
+    CHECK_EQ(memory.read(data, second), 7u);
+    CHECK_EQ(memory.read(data, first), 100u + VM_PAGE_SIZE / IMAGE_WORD_STRIDE);
+    CHECK(first.address_space->find(1)->frame != second.address_space->find(1)->frame);
+    CHECK_EQ(memory.swapSlotRefs(data_slot), 1u);
+    CHECK_EQ(second.address_space->find(1)->swap_slot, NO_SWAP_SLOT);
+    CHECK_EQ(memory.swapSlotRefs(text_slot), 2u);   // Texto continua compartilhado
+
+    // Dono único do slot: a escrita só tira a marca COW, sem outra cópia
+    memory.write(data, 9, first);
+    CHECK_EQ(first.cow_copies.load(), 0u);
+    CHECK(!memory.hasSharedFrame(data_slot));
+    CHECK_EQ(memory.read(data, first), 9u);
+    CHECK_EQ(memory.read(data, second), 7u);
+    CHECK_EQ(memory.read(0, second), 100u);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "\n==============================================================\n";
+    std::cout << "  TESTE: MemoryManager (contadores, classes da L2, copy-on-write)\n";
+    std::cout << "==============================================================\n";
+    test_prefetch_coverage_writes();
+    test_cache_class_reservation();
+    test_prefetch_fills_l2();
+    test_copy_on_write();
+    return test_summary("MemoryManager");
+}
@@ -36,6 +36,11 @@ std::string build_csv_path(int num_cores) {
            std::to_string(std::max(1, num_cores)) + "cores.csv";
 }
 
+std::string build_sets_csv_path(int num_cores) {
+    return std::string(DATA_ROOT) + "/csv/cache_conjuntos_" +
+           std::to_string(std::max(1, num_cores)) + "cores.csv";
+}
+
 std::string build_report_path(int num_cores) {
     return std::string(DATA_ROOT) + "/reports/relatorio_metricas_" +
            std::to_string(std::max(1, num_cores)) + "cores.txt";
@@ -78,6 +83,25 @@ struct PolicyMetrics {
     long cache_hits{0};
     long cache_misses{0};
     double hit_rate_pct{0.0};
+    long miss_compulsory{0};
+    long miss_capacity{0};
+    long miss_conflict{0};
+    long ifetch_hits{0};          // L1I (buscas de instrução, fora de cache_hits)
+    long ifetch_misses{0};
+    long fetch_buffer_hits{0};
+    long bus_transfers{0};
+    long bus_queue_cycles{0};     // Espera pelo árbitro (cresce com a saturação do barramento)
+    long memory_cycles{0};
+    long noc_cycles{0};
+    long noc_wait_cycles{0};
+    long io_blocked_cycles{0};    // Do PRINT até a conclusão no IOManager
+    long io_overlap_cycles{0};    // Parte coberta por outros processos nos núcleos
+    std::vector<std::pair<int, std::vector<CacheSetStats>>> cache_sets;   // L1 de cada núcleo
+    long prefetch_issued{0};
+    double prefetch_accuracy_pct{0.0};
+    double prefetch_coverage_pct{0.0};
+    long lock_contentions{0};
+    double avg_lock_wait_us{0.0};
     int processes_finished{0};
     int processes_failed{0};
     bool success{false};
@@ -142,7 +166,9 @@ void print_workloads(const std::vector<WorkloadConfig>& workloads) {
 
 PolicyMetrics run_policy(const std::string& policy,
                          int num_cores,
-                         const std::vector<WorkloadConfig>& workloads) {
+                         const std::vector<WorkloadConfig>& workloads,
+                         const NocConfig& noc_config,
+                         size_t bus_width) {
     PolicyMetrics metrics;
     metrics.policy = policy;
     metrics.processes_finished = 0;
@@ -156,6 +182,13 @@ PolicyMetrics run_policy(const std::string& policy,
         MemoryManager::resetStats();
         auto memManager = std::make_unique<MemoryManager>(4096, 32768);
         auto ioManager = std::make_unique<IOManager>();
+        // Com barramento a escala com núcleos reflete a banda simulada, não as travas do host
+        if (bus_width > 0) {
+            BusConfig bus_config;
+            bus_config.width = bus_width;
+            memManager->enableBus(bus_config);
+        }
+        if (noc_config.enabled()) memManager->enableInterconnect(noc_config, num_cores);
 
         for (size_t i = 0; i < workloads.size(); ++i) {
             const auto& workload = workloads[i];
@@ -235,6 +268,33 @@ PolicyMetrics run_policy(const std::string& policy,
             metrics.cache_misses = memManager->getTotalCacheMisses();
             const long total = metrics.cache_hits + metrics.cache_misses;
             metrics.hit_rate_pct = total > 0 ? (metrics.cache_hits * 100.0 / total) : 0.0;
+            const auto& mem_stats = MemoryManager::getStats();
+            metrics.prefetch_issued = static_cast<long>(mem_stats.prefetch_issued);
+            metrics.prefetch_accuracy_pct = mem_stats.get_prefetch_accuracy();
+            metrics.prefetch_coverage_pct = mem_stats.get_prefetch_coverage();
+            metrics.lock_contentions = static_cast<long>(mem_stats.lock_contentions);
+            metrics.avg_lock_wait_us = mem_stats.get_avg_lock_wait_us();
+            metrics.ifetch_hits = static_cast<long>(mem_stats.ifetch_hits);
+            metrics.ifetch_misses = static_cast<long>(mem_stats.ifetch_misses);
+            metrics.fetch_buffer_hits = static_cast<long>(mem_stats.fetch_buffer_hits);
+            metrics.bus_transfers = static_cast<long>(mem_stats.bus_transfers);
+            metrics.bus_queue_cycles = static_cast<long>(mem_stats.bus_queue_cycles);
+            for (const auto* pcb : process_ptrs) {
+                metrics.miss_compulsory += static_cast<long>(pcb->miss_compulsory.load());
+                metrics.miss_capacity += static_cast<long>(pcb->miss_capacity.load());
+                metrics.miss_conflict += static_cast<long>(pcb->miss_conflict.load());
+                metrics.memory_cycles += static_cast<long>(pcb->memory_cycles.load());
+                metrics.noc_cycles += static_cast<long>(pcb->noc_cycles.load());
+                metrics.noc_wait_cycles += static_cast<long>(pcb->noc_wait_cycles.load());
+                metrics.io_blocked_cycles += static_cast<long>(pcb->io_overlap_cycles.load() + pcb->io_stall_cycles.load());
+                metrics.io_overlap_cycles += static_cast<long>(pcb->io_overlap_cycles.load());
+            }
+        };
+
+        auto collect_sets = [&](const std::vector<std::unique_ptr<Core>>& cores) {
+            for (const auto& core : cores) {
+                metrics.cache_sets.emplace_back(core->get_id(), core->get_l1_cache().setStats());
+            }
         };
 
         if (policy == "RR")
@@ -256,6 +316,7 @@ PolicyMetrics run_policy(const std::string& policy,
             }
             metrics.processes_finished = scheduler.get_finished_count();
             metrics.processes_failed += scheduler.get_failed_count();
+            collect_sets(scheduler.get_cores());
             finalize_stats(scheduler.get_statistics());
         }
         else if (policy == "FCFS")
@@ -286,6 +347,7 @@ PolicyMetrics run_policy(const std::string& policy,
                 metrics.error = "FCFS atingiu o limite de ciclos antes de concluir todos os processos";
             }
 
+            collect_sets(scheduler.get_cores());
             finalize_stats(scheduler.get_statistics());
         }
         else if (policy == "SJN")
@@ -316,6 +378,7 @@ PolicyMetrics run_policy(const std::string& policy,
                 metrics.error = "SJN atingiu o limite de ciclos antes de concluir todos os processos";
             }
 
+            collect_sets(scheduler.get_cores());
             finalize_stats(scheduler.get_statistics());
         }
         else if (policy == "PRIORITY")
@@ -346,6 +409,7 @@ PolicyMetrics run_policy(const std::string& policy,
                 metrics.error = "PRIORITY atingiu o limite de ciclos antes de concluir todos os processos";
             }
 
+            collect_sets(scheduler.get_cores());
             finalize_stats(scheduler.get_statistics());
         }
         else
@@ -388,7 +452,8 @@ void write_csv(const std::vector<PolicyMetrics>& results, const std::string& csv
     }
 
         csv << "Politica,TempoMedioEspera_ms,TempoMedioExecucao_us,TempoMedioTurnaround_ms,CPUUtilizacao_pct,"
-            "Eficiencia_pct,Throughput_proc_s,CacheHits,CacheMisses,TaxaHit_pct,FailedProcesses,Success,Error\n";
+            "Eficiencia_pct,Throughput_proc_s,CacheHits,CacheMisses,TaxaHit_pct,MissCompulsorio,MissCapacidade,MissConflito,"
+            "IFetchHits,IFetchMisses,FetchBufferHits,BusTransfers,BusWaitCycles,MemoryCycles,NocCycles,NocWaitCycles,IoBlockedCycles,IoOverlapCycles,FailedProcesses,Success,Error\n";
 
     csv << std::fixed;
     for (const auto& result : results) {
@@ -402,12 +467,45 @@ void write_csv(const std::vector<PolicyMetrics>& results, const std::string& csv
             << result.cache_hits << ","
             << result.cache_misses << ","
             << std::setprecision(2) << result.hit_rate_pct << ","
+            << result.miss_compulsory << ","
+            << result.miss_capacity << ","
+            << result.miss_conflict << ","
+            << result.ifetch_hits << ","
+            << result.ifetch_misses << ","
+            << result.fetch_buffer_hits << ","
+            << result.bus_transfers << ","
+            << result.bus_queue_cycles << ","
+            << result.memory_cycles << ","
+            << result.noc_cycles << ","
+            << result.noc_wait_cycles << ","
+            << result.io_blocked_cycles << ","
+            << result.io_overlap_cycles << ","
             << result.processes_failed << ","
             << std::boolalpha << result.success << ","
             << "\"" << result.error << "\"" << "\n";
     }
 }
 
+// Mapa de calor da L1: acessos e misses de cada conjunto, por política e núcleo
+void write_sets_csv(const std::vector<PolicyMetrics>& results, const std::string& csv_path) {
+    std::ofstream csv(csv_path);
+    if (!csv.is_open()) {
+        throw std::runtime_error(std::string("Não foi possível criar ") + csv_path);
+    }
+
+    csv << "Politica,Core,Conjunto,Acessos,Misses,MissCompulsorio,MissCapacidade,MissConflito\n";
+    for (const auto& result : results) {
+        for (const auto& [core, sets] : result.cache_sets) {
+            for (size_t set = 0; set < sets.size(); ++set) {
+                const CacheSetStats& stats = sets[set];
+                csv << result.policy << "," << core << "," << set << ","
+                    << stats.accesses << "," << stats.misses << ","
+                    << stats.compulsory << "," << stats.capacity << "," << stats.conflict << "\n";
+            }
+        }
+    }
+}
+
 void write_report(const std::vector<PolicyMetrics>& results,
                   const std::vector<WorkloadConfig>& workloads,
                   int num_cores,
@@ -449,6 +547,25 @@ void write_report(const std::vector<PolicyMetrics>& results,
         report << "  • Cache hits:                " << result.cache_hits << "\n";
         report << "  • Cache misses:              " << result.cache_misses << "\n";
         report << "  • Taxa de hit:               " << result.hit_rate_pct << " %\n";
+        report << "  • Misses comp./cap./conf.:   " << result.miss_compulsory << " / "
+               << result.miss_capacity << " / " << result.miss_conflict << "\n";
+        report << "  • Buscas (buffer/L1I hit/miss): " << result.fetch_buffer_hits << " / "
+               << result.ifetch_hits << " / " << result.ifetch_misses << "\n";
+        report << "  • Barramento (transf./espera): " << result.bus_transfers << " / "
+               << result.bus_queue_cycles << " ciclos\n";
+        if (result.noc_cycles > 0) {
+            report << "  • NoC (ciclos/espera):       " << result.noc_cycles << " / "
+                   << result.noc_wait_cycles << "\n";
+        }
+        if (result.io_blocked_cycles > 0) {
+            report << "  • I/O (bloqueado/sobreposto): " << result.io_blocked_cycles << " / "
+                   << result.io_overlap_cycles << " ciclos\n";
+        }
+        report << "  • Prefetches emitidos:       " << result.prefetch_issued << "\n";
+        report << "  • Precisão do prefetch:      " << result.prefetch_accuracy_pct << " %\n";
+        report << "  • Cobertura do prefetch:     " << result.prefetch_coverage_pct << " %\n";
+        report << "  • Contenções de trava:       " << result.lock_contentions << "\n";
+        report << "  • Espera média por trava:    " << result.avg_lock_wait_us << " µs\n";
         report << "  • Processos com falha:      " << result.processes_failed << "\n\n";
     }
 
@@ -464,7 +581,14 @@ int main() {
     std::cout << "║     TESTE DE MÉTRICAS POR NÚCLEOS FIXOS - MULTICORE        ║\n";
     std::cout << "╚══════════════════════════════════════════════════════════════╝\n\n";
 
-    const int num_cores = DEFAULT_NUM_CORES;
+    // Configurações grandes (16-256 núcleos) com rede-em-chip: TEST_NUM_CORES=64 TEST_NOC=mesh
+    const char* env_cores = std::getenv("TEST_NUM_CORES");
+    const int num_cores = env_cores ? std::max(1, std::atoi(env_cores)) : DEFAULT_NUM_CORES;
+    NocConfig noc_config;
+    if (const char* env_noc = std::getenv("TEST_NOC")) noc_config.topology = Interconnect::parseTopology(env_noc);
+    // Barramento até a RAM (palavras por ciclo); desligado por padrão, como a NoC: TEST_BUS_WIDTH=4
+    const char* env_bus = std::getenv("TEST_BUS_WIDTH");
+    const size_t bus_width = env_bus ? static_cast<size_t>(std::max(0, std::atoi(env_bus))) : 0;
     const std::vector<WorkloadConfig> workloads = load_workloads(PROCESS_DIR, TASKS_DIR);
     if (workloads.empty()) {
         std::cerr << "❌ Nenhum workload encontrado em '" << PROCESS_DIR
@@ -476,6 +600,12 @@ int main() {
 
     std::cout << "Configuração atual:\n";
     std::cout << "  • Núcleos fixos: " << num_cores << "\n";
+    if (noc_config.enabled()) {
+        std::cout << "  • NoC: " << Interconnect::topologyName(noc_config.topology) << "\n";
+    }
+    if (bus_width > 0) {
+        std::cout << "  • Barramento: " << bus_width << " palavras/ciclo\n";
+    }
     std::cout << "  • Políticas: RR, FCFS, SJN, PRIORITY\n";
     std::cout << "  • Workloads: " << workloads.size() << "\n";
     std::cout << "  • Listagem:\n";
@@ -496,7 +626,7 @@ int main() {
     for (const auto& policy : policies) {
         std::cout << "  → " << policy << "..." << std::flush;
 
-        PolicyMetrics metrics = run_policy(policy, num_cores, workloads);
+        PolicyMetrics metrics = run_policy(policy, num_cores, workloads, noc_config, bus_width);
         if (metrics.success) {
             std::cout << " ok (CPU " << std::fixed << std::setprecision(1)
                       << metrics.cpu_util_pct << "%, hit "
@@ -510,12 +640,15 @@ int main() {
 
     const std::string csv_path = build_csv_path(num_cores);
     const std::string report_path = build_report_path(num_cores);
+    const std::string sets_path = build_sets_csv_path(num_cores);
 
     try {
         write_csv(results, csv_path);
+        write_sets_csv(results, sets_path);
         write_report(results, workloads, num_cores, report_path);
         std::cout << "\nArquivos gerados:\n";
         std::cout << "  • " << csv_path << "\n";
+        std::cout << "  • " << sets_path << "\n";
         std::cout << "  • " << report_path << "\n";
     } catch (const std::exception& ex) {
         std::cerr << "❌ Falha ao escrever arquivos: " << ex.what() << "\n";
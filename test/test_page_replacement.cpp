@@ -0,0 +1,167 @@
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "memory/PageReplacement.hpp"
+#include "TestCheck.hpp"
+
+namespace {
+
+// Mini paginador sobre a interface do MemoryManager: quadros, PTEs de um espaço e
+// a política escolhendo a vítima quando não há quadro livre
+struct Pager {
+    AddressSpace space{1};
+    std::vector<FrameInfo> frames;
+    std::unique_ptr<PageReplacer> replacer;
+    std::vector<bool> pinned;
+    uint64_t tick = 0;
+    size_t faults = 0;
+    std::vector<uint32_t> victims;   // VPNs despejadas, na ordem
+
+    Pager(PageReplacementPolicy policy, size_t count, uint64_t ws_window = 0)
+        : frames(count), replacer(PageReplacer::create(policy, ws_window)), pinned(count, false) {}
+
+    // Acesso a `vpn`: marca R (e M na escrita) e, se não residente, faz a falta
+    void reference(uint32_t vpn, bool write = false) {
+        space.tick();
+        PageTableEntry& pte = space.entry(vpn);
+        if (!pte.present) fault(vpn);
+        pte.referenced = true;
+        if (write) pte.dirty = true;
+    }
+
+    void fault(uint32_t vpn) {
+        ++faults;
+        size_t index = NO_VICTIM;
+        for (size_t i = 0; i < frames.size() && index == NO_VICTIM; ++i) {
+            if (!frames[i].used) index = i;
+        }
+        if (index == NO_VICTIM) {
+            index = replacer->selectVictim(frames, [&](size_t i) { return frames[i].used && !pinned[i]; });
+            if (index == NO_VICTIM) return;
+            victims.push_back(frames[index].vpn);
+            space.unmap(*frames[index].pte);
+        }
+        PageTableEntry& pte = space.map(vpn, static_cast<uint32_t>(index));
+        FrameInfo& frame = frames[index];
+        frame.used = true;
+        frame.owner = &space;
+        frame.vpn = vpn;
+        frame.pte = &pte;
+        frame.loaded_at = ++tick;
+        frame.last_use = space.virtualTime();
+        frame.age = 0;
+    }
+
+    void run(const std::vector<uint32_t>& refs) {
+        for (uint32_t vpn : refs) reference(vpn);
+    }
+};
+
+// Cadeia clássica de referências (Silberschatz) com 3 quadros
+const std::vector<uint32_t> CLASSIC = {7, 0, 1, 2, 0, 3, 0, 4, 2, 3, 0, 3, 2, 1, 2, 0, 1, 7, 0, 1};
+
+void test_fifo() {
+    test_section("FIFO: sai o quadro carregado há mais tempo (e a anomalia de Belady)");
+    Pager pager(PageReplacementPolicy::FIFO, 3);
+    pager.run(CLASSIC);
+    CHECK_EQ(pager.faults, 15u);
+    CHECK(pager.victims == std::vector<uint32_t>({7, 0, 1, 2, 3, 0, 4, 2, 3, 0, 1, 2}));
+
+    // Mais quadros, mais faltas: 9 com 3 quadros, 10 com 4
+    const std::vector<uint32_t> belady = {1, 2, 3, 4, 1, 2, 5, 1, 2, 3, 4, 5};
+    Pager three(PageReplacementPolicy::FIFO, 3);
+    Pager four(PageReplacementPolicy::FIFO, 4);
+    three.run(belady);
+    four.run(belady);
+    CHECK_EQ(three.faults, 9u);
+    CHECK_EQ(four.faults, 10u);
+}
+
+void test_clock() {
+    test_section("Clock: página com R=1 perde o bit e ganha uma segunda chance");
+    Pager pager(PageReplacementPolicy::Clock, 3);
+    // 1 2 3 enchem os quadros com R=1; na falta do 4 o ponteiro zera os três e
+    // volta ao quadro 0 (página 1). O 2 é referenciado de novo e sobrevive à falta
+    // do 5 (sai o 3), mas gasta a segunda chance: na falta do 1 o 4 fica e o 2 sai.
+    pager.run({1, 2, 3, 4, 2, 5, 1});
+    CHECK(pager.victims == std::vector<uint32_t>({1, 3, 2}));
+    CHECK_EQ(pager.faults, 6u);
+    CHECK_EQ(pager.frames[0].vpn, 4u);
+
+    // Sem nenhuma referência repetida o Clock se comporta como o FIFO
+    Pager clock(PageReplacementPolicy::Clock, 3);
+    Pager fifo(PageReplacementPolicy::FIFO, 3);
+    clock.run({1, 2, 3, 4, 5, 6, 7});
+    fifo.run({1, 2, 3, 4, 5, 6, 7});
+    CHECK(clock.victims == fifo.victims);
+}
+
+void test_wsclock() {
+    test_section("WSClock: fora da janela sai a página limpa antes da suja");
+    Pager pager(PageReplacementPolicy::WSClock, 3, 4);
+    pager.reference(1);
+    pager.reference(2, true);    // Suja
+    pager.reference(3);
+    // Varredura do 4: zera os bits R e atualiza last_use; ninguém sai da janela,
+    // o primeiro quadro sem uso recente (página 1) é o substituto
+    pager.reference(4);
+    CHECK(pager.victims == std::vector<uint32_t>({1}));
+
+    // Páginas 2 e 3 envelhecem além da janela de 4 acessos; só a 4 continua em uso.
+    // Na falta do 5 o ponteiro passa pela 2 (velha e suja) e para na 3 (velha e limpa)
+    for (int i = 0; i < 5; ++i) pager.reference(4);
+    pager.reference(5);
+    CHECK(pager.victims == std::vector<uint32_t>({1, 3}));
+
+    // Falta do 6: a 4 está sem uso, mas dentro da janela; a 2 velha e suja sai antes dela
+    pager.reference(6);
+    CHECK(pager.victims == std::vector<uint32_t>({1, 3, 2}));
+}
+
+void test_aging() {
+    test_section("Aging: a cada falta o bit R entra na idade; sai a menor idade");
+    Pager pager(PageReplacementPolicy::Aging, 3);
+    pager.run({1, 2, 3});
+    // Falta do 4: todos com R=1 -> idade 0x80; empate, sai o mais antigo (1)
+    pager.run({4});
+    CHECK(pager.victims == std::vector<uint32_t>({1}));
+    // Só o 2 é usado: na falta do 5 fica com 0xC0, o 3 com 0x40 e o 4 com 0x80
+    pager.run({2, 5});
+    CHECK(pager.victims == std::vector<uint32_t>({1, 3}));
+    CHECK_EQ(pager.frames[1].age, 0xC0);
+    // 2 e 4 sem uso; na falta do 6: 2 -> 0x60, 4 -> 0x40, 5 -> 0x80
+    pager.run({6});
+    CHECK(pager.victims == std::vector<uint32_t>({1, 3, 4}));
+}
+
+void test_pinned_frames() {
+    test_section("Quadros de processos em execução não saem (NO_VICTIM se todos estão presos)");
+    Pager pager(PageReplacementPolicy::FIFO, 2);
+    pager.run({1, 2});
+    pager.pinned[0] = true;
+    pager.run({3});
+    CHECK(pager.victims == std::vector<uint32_t>({2}));
+
+    pager.pinned[1] = true;
+    for (PageReplacementPolicy policy : {PageReplacementPolicy::FIFO, PageReplacementPolicy::Clock,
+                                         PageReplacementPolicy::WSClock, PageReplacementPolicy::Aging}) {
+        auto replacer = PageReplacer::create(policy, 4);
+        CHECK_EQ(replacer->selectVictim(pager.frames, [](size_t) { return false; }), NO_VICTIM);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::cout << "\n==============================================================\n";
+    std::cout << "  TESTE: substituição de páginas (FIFO, Clock, WSClock, Aging)\n";
+    std::cout << "==============================================================\n";
+    test_fifo();
+    test_clock();
+    test_wsclock();
+    test_aging();
+    test_pinned_frames();
+    return test_summary("Substituição de páginas");
+}